@@ -1,5 +1,4 @@
 #include <string>
-#include <utility>
 #include <vector>
 
 #include "puzzles/day_03/tree_map.h"
@@ -10,7 +9,7 @@ int main(int argc, char** argv) {
   CHECK(argc == 2);
   std::vector<std::string> lines = aoc2020::ReadLinesFromFile(argv[1]);
 
-  aoc2020::day03::TreeMap map(std::move(lines));
+  aoc2020::day03::TreeMap map(lines);
   std::cout << map.CountTreesOnPath(1, 3) << "\n";
   return 0;
 }
@@ -1,7 +1,5 @@
 #include <cstdint>
 #include <string>
-#include <utility>
-#include <vector>
 
 #include "puzzles/day_03/tree_map.h"
 #include "util/check.h"
@@ -9,13 +7,22 @@
 
 int main(int argc, char** argv) {
   CHECK(argc == 2);
-  std::vector<std::string> lines = aoc2020::ReadLinesFromFile(argv[1]);
 
-  aoc2020::day03::TreeMap map(std::move(lines));
-  const std::int64_t product =
-      map.CountTreesOnPath(1, 1) * map.CountTreesOnPath(1, 3) *
-      map.CountTreesOnPath(1, 5) * map.CountTreesOnPath(1, 7) *
-      map.CountTreesOnPath(2, 1);
+  aoc2020::day03::StreamingSlopeCounter counter({{.down = 1, .right = 1},
+                                                 {.down = 1, .right = 3},
+                                                 {.down = 1, .right = 5},
+                                                 {.down = 1, .right = 7},
+                                                 {.down = 2, .right = 1}});
+  aoc2020::LineReader reader(argv[1]);
+  std::string line;
+  while (reader.Next(&line)) {
+    counter.AddRow(line);
+  }
+
+  std::int64_t product = 1;
+  for (const std::int64_t count : counter.trees()) {
+    product *= count;
+  }
   std::cout << product << "\n";
   return 0;
 }
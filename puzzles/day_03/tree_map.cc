@@ -1,32 +1,85 @@
 #include "puzzles/day_03/tree_map.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 
-#include "absl/types/optional.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "util/check.h"
 
 namespace aoc2020::day03 {
 
+SlopeCursor::SlopeCursor(const Slope& slope, const std::size_t width)
+    : down_(slope.down), right_(slope.right), width_(width) {
+  CHECK(slope.down > 0);
+  CHECK(slope.right >= 0);
+  CHECK(width > 0);
+  // Reduce the step once up front so that a single conditional subtraction
+  // (which compiles to a cmov) is enough to wrap around on each row.
+  right_ %= width_;
+}
+
+TreeMap::TreeMap(const std::vector<std::string>& map)
+    : height_(map.size()),
+      width_(map.empty() ? 0 : map.front().size()),
+      words_per_row_((width_ + kLowMask) >> kHighShift),
+      rows_(height_ * words_per_row_, 0) {
+  for (std::size_t vertical = 0; vertical < height_; ++vertical) {
+    CHECK(map[vertical].size() == width_);
+    std::uint64_t* row = &rows_[vertical * words_per_row_];
+    for (std::size_t horizontal = 0; horizontal < width_; ++horizontal) {
+      row[horizontal >> kHighShift] |=
+          std::uint64_t{map[vertical][horizontal] == '#'}
+          << (horizontal & kLowMask);
+    }
+  }
+}
+
 std::int64_t TreeMap::CountTreesOnPath(const int step_down,
                                        const int step_right) const {
-  absl::optional<Coords> position = Coords();
+  CHECK(step_down > 0);
+  CHECK(step_right >= 0);
+  if (width_ == 0) return 0;
+
+  SlopeCursor cursor(Slope{.down = step_down, .right = step_right}, width_);
   std::int64_t trees = 0;
-  while (position.has_value()) {
-    trees += IsTree(*position);
-    position = NextPosition(*position, step_down, step_right);
+  for (std::size_t vertical = 0; vertical < height_; vertical += step_down) {
+    trees += IsTree(vertical, cursor.horizontal());
+    cursor.Advance();
   }
   return trees;
 }
 
-absl::optional<TreeMap::Coords> TreeMap::NextPosition(Coords original,
-                                                      const int down,
-                                                      const int right) const {
-  original.vertical += down;
-  if (original.vertical >= map_.size()) return absl::nullopt;
+StreamingSlopeCounter::StreamingSlopeCounter(absl::Span<const Slope> slopes)
+    : slopes_(slopes.begin(), slopes.end()), trees_(slopes.size(), 0) {
+  for (const Slope& slope : slopes_) {
+    CHECK(slope.down > 0);
+    CHECK(slope.right >= 0);
+  }
+}
 
-  original.horizontal += right;
-  original.horizontal %= map_[original.vertical].size();
+void StreamingSlopeCounter::AddRow(absl::string_view row) {
+  if (vertical_ == 0) {
+    // The width isn't known until the first row arrives.
+    width_ = row.size();
+    if (width_ != 0) {
+      cursors_.reserve(slopes_.size());
+      for (const Slope& slope : slopes_) {
+        cursors_.emplace_back(slope, width_);
+      }
+    }
+  }
+  CHECK(row.size() == width_);
 
-  return original;
+  for (std::size_t idx = 0; idx < cursors_.size(); ++idx) {
+    SlopeCursor& cursor = cursors_[idx];
+    if (!cursor.OnRow(vertical_)) continue;
+    trees_[idx] += (row[cursor.horizontal()] == '#');
+    cursor.Advance();
+  }
+  ++vertical_;
 }
 
 }  // namespace aoc2020::day03
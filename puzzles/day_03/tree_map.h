@@ -1,36 +1,98 @@
 #ifndef PUZZLES_DAY_03_TREE_MAP_H_
 #define PUZZLES_DAY_03_TREE_MAP_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
-#include "absl/types/optional.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace aoc2020::day03 {
 
+struct Slope {
+  int down = 1;
+  int right = 0;
+};
+
+// Follows one slope down a map that is `width` squares wide, wrapping around
+// horizontally. Rows must be offered in order, starting from row 0.
+class SlopeCursor {
+ public:
+  SlopeCursor(const Slope& slope, std::size_t width);
+
+  // Whether the path crosses row `vertical`.
+  bool OnRow(const std::size_t vertical) const {
+    return next_vertical_ == vertical;
+  }
+
+  // The column at which the path crosses the current row.
+  std::size_t horizontal() const { return horizontal_; }
+
+  // Moves on to the next row the path crosses.
+  void Advance() {
+    next_vertical_ += down_;
+    horizontal_ += right_;
+    horizontal_ -= (horizontal_ >= width_) ? width_ : 0;
+  }
+
+ private:
+  std::size_t next_vertical_ = 0;
+  std::size_t horizontal_ = 0;
+  std::size_t down_;
+  std::size_t right_;
+  std::size_t width_;
+};
+
+// A map of trees stored as packed bits, one bit per square. Each row occupies
+// a whole number of 64-bit words so that rows of any width can be addressed
+// without straddling.
 class TreeMap {
  public:
-  explicit TreeMap(std::vector<std::string> map) : map_(std::move(map)) {}
+  explicit TreeMap(const std::vector<std::string>& map);
 
   std::int64_t CountTreesOnPath(int step_down, int step_right) const;
 
  private:
-  struct Coords {
-    int vertical = 0;
-    int horizontal = 0;
-  };
-
-  absl::optional<Coords> NextPosition(Coords original, int down,
-                                      int right) const;
+  static inline constexpr std::size_t kHighShift = 6;
+  static inline constexpr std::size_t kLowMask = 63;
 
-  bool IsTree(Coords coords) const {
-    return map_[coords.vertical][coords.horizontal] == '#';
+  bool IsTree(std::size_t vertical, std::size_t horizontal) const {
+    const std::uint64_t word =
+        rows_[vertical * words_per_row_ + (horizontal >> kHighShift)];
+    return (word >> (horizontal & kLowMask)) & 1;
   }
 
-  std::vector<std::string> map_;
+  std::size_t height_ = 0;
+  std::size_t width_ = 0;
+  std::size_t words_per_row_ = 0;
+  std::vector<std::uint64_t> rows_;
+};
+
+// Counts trees along several slopes while rows are fed in one at a time, so
+// that only the current row (and one cursor per slope) is ever held in memory.
+// Useful for maps too tall to load as a whole TreeMap.
+class StreamingSlopeCounter {
+ public:
+  explicit StreamingSlopeCounter(absl::Span<const Slope> slopes);
+
+  // Advances every slope past `row`, which must be the same width as all
+  // previously added rows.
+  void AddRow(absl::string_view row);
+
+  // Trees encountered so far, in the same order as the slopes passed to the
+  // constructor.
+  const std::vector<std::int64_t>& trees() const { return trees_; }
+
+ private:
+  std::size_t vertical_ = 0;
+  std::size_t width_ = 0;
+  std::vector<Slope> slopes_;
+  std::vector<SlopeCursor> cursors_;
+  std::vector<std::int64_t> trees_;
 };
 
 }  // namespace aoc2020::day03
 
-#endif  // PUZZLES_DAY_03_TREE_MAP_H_
\ No newline at end of file
+#endif  // PUZZLES_DAY_03_TREE_MAP_H_
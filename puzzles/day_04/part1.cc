@@ -1,13 +1,10 @@
-#include <cstddef>
 #include <cstdint>
 #include <iostream>
-#include <utility>
-#include <vector>
+#include <string>
 
 #include "absl/container/flat_hash_map.h"
-#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
-#include "absl/types/span.h"
+#include "puzzles/day_04/passport_scanner.h"
 #include "util/check.h"
 #include "util/io.h"
 
@@ -15,15 +12,10 @@ namespace {
 
 class PassportFields {
  public:
-  explicit PassportFields(absl::Span<const std::string> lines) {
-    for (const std::string& line : lines) {
-      if (line.empty()) continue;
-      for (absl::string_view field_value : absl::StrSplit(line, ' ')) {
-        auto iter = fields_->find(field_value.substr(0, 3));
-        CHECK(iter != fields_->end());
-        rep_ |= iter->second;
-      }
-    }
+  void AddField(absl::string_view field, absl::string_view) {
+    auto iter = fields_->find(field);
+    CHECK(iter != fields_->end());
+    rep_ |= iter->second;
   }
 
   bool IsValid() const {
@@ -31,6 +23,8 @@ class PassportFields {
     return (rep_ & kMask) == kMask;
   }
 
+  void Clear() { rep_ = 0; }
+
  private:
   static const absl::flat_hash_map<std::string, std::uint8_t>* fields_;
 
@@ -46,14 +40,19 @@ const absl::flat_hash_map<std::string, std::uint8_t>* PassportFields::fields_ =
 
 int main(int argc, char** argv) {
   CHECK(argc == 2);
-  std::vector<std::string> lines = aoc2020::ReadLinesFromFile(argv[1]);
-  std::vector<std::vector<std::string>> passport_strs =
-      aoc2020::SplitByEmptyStrings(std::move(lines));
+  const std::string contents = aoc2020::ReadFile(argv[1]);
 
   int valid_passports = 0;
-  for (const std::vector<std::string> passport_desc : passport_strs) {
-    valid_passports += PassportFields(passport_desc).IsValid();
-  }
+  PassportFields passport;
+  aoc2020::day04::ScanPassports(
+      contents,
+      [&passport](absl::string_view field, absl::string_view value) {
+        passport.AddField(field, value);
+      },
+      [&passport, &valid_passports]() {
+        valid_passports += passport.IsValid();
+        passport.Clear();
+      });
   std::cout << valid_passports << "\n";
 
   return 0;
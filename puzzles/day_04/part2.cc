@@ -1,112 +1,128 @@
-#include <cctype>
-#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
-#include <utility>
-#include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/strings/numbers.h"
-#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
-#include "absl/types/span.h"
-#include "re2/re2.h"
+#include "puzzles/day_04/passport_scanner.h"
 #include "util/check.h"
 #include "util/io.h"
 
 namespace {
 
-class FieldValidator {
- public:
-  std::uint8_t Validate(absl::string_view value) const {
-    return IsValid(value) ? check_bit_ : 0;
-  }
+// Packs a 3-character field name (or value) into an integer so that it can be
+// used as a switch label.
+constexpr std::uint32_t PackKey(const char a, const char b, const char c) {
+  return static_cast<std::uint32_t>(static_cast<unsigned char>(a)) |
+         (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8) |
+         (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16);
+}
 
- protected:
-  explicit FieldValidator(int bit_position) : check_bit_(1 << bit_position) {}
+constexpr std::uint32_t PackKey(const char (&key)[4]) {
+  return PackKey(key[0], key[1], key[2]);
+}
 
- private:
-  virtual bool IsValid(absl::string_view value) const = 0;
+std::uint32_t PackKey(absl::string_view key) {
+  return PackKey(key[0], key[1], key[2]);
+}
 
-  std::uint8_t check_bit_;
-};
+bool IsDigit(const char c) { return c >= '0' && c <= '9'; }
 
-class NoopFieldValidator final : public FieldValidator {
- public:
-  explicit NoopFieldValidator(int bit_position)
-      : FieldValidator(bit_position) {}
+bool IsHexDigit(const char c) {
+  return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
 
- private:
-  bool IsValid(absl::string_view) const override { return true; }
-};
+bool AllDigits(absl::string_view value) {
+  for (const char c : value) {
+    if (!IsDigit(c)) return false;
+  }
+  return true;
+}
 
-class IntFieldValidator final : public FieldValidator {
- public:
-  explicit IntFieldValidator(int bit_position, int min, int max)
-      : FieldValidator(bit_position), min_(min), max_(max) {}
+// Parses `value` as an int in [min, max]. Accepts whatever absl::SimpleAtoi
+// does, including a sign and surrounding whitespace.
+bool IntInRange(absl::string_view value, const int min, const int max) {
+  int parsed = 0;
+  if (!absl::SimpleAtoi(value, &parsed)) return false;
+  return (min <= parsed) && (parsed <= max);
+}
 
- private:
-  bool IsValid(absl::string_view value) const override {
-    int parsed = 0;
-    if (!absl::SimpleAtoi(value, &parsed)) return false;
-    return (min_ <= parsed) && (parsed <= max_);
-  }
+// Matches `[[:digit:]]+` with a value in [min, max].
+bool DigitsInRange(absl::string_view value, const int min, const int max) {
+  return !value.empty() && AllDigits(value) && IntInRange(value, min, max);
+}
 
-  int min_;
-  int max_;
-};
+// Matches `([[:digit:]]+)(cm|in)` with a height range depending on the units.
+bool HeightValid(absl::string_view value) {
+  if (value.size() < 3) return false;
+  const absl::string_view digits = value.substr(0, value.size() - 2);
+  const absl::string_view units = value.substr(value.size() - 2);
+  if (units == "cm") return DigitsInRange(digits, 150, 193);
+  if (units == "in") return DigitsInRange(digits, 59, 76);
+  return false;
+}
 
-class RegexFieldValidator final : public FieldValidator {
- public:
-  explicit RegexFieldValidator(int bit_position, absl::string_view pattern)
-      : FieldValidator(bit_position), pattern_(pattern) {
-    CHECK(pattern_.ok());
+// Matches `#[[:xdigit:]]{6}`.
+bool HairColorValid(absl::string_view value) {
+  if (value.size() != 7 || value[0] != '#') return false;
+  for (const char c : value.substr(1)) {
+    if (!IsHexDigit(c)) return false;
   }
+  return true;
+}
 
- private:
-  bool IsValid(absl::string_view value) const override {
-    return re2::RE2::FullMatch(value, pattern_);
+// Matches `amb|blu|brn|gry|grn|hzl|oth`.
+bool EyeColorValid(absl::string_view value) {
+  if (value.size() != 3) return false;
+  switch (PackKey(value)) {
+    case PackKey("amb"):
+    case PackKey("blu"):
+    case PackKey("brn"):
+    case PackKey("gry"):
+    case PackKey("grn"):
+    case PackKey("hzl"):
+    case PackKey("oth"):
+      return true;
+    default:
+      return false;
   }
+}
 
-  re2::RE2 pattern_;
-};
-
-class HgtFieldValidator final : public FieldValidator {
- public:
-  explicit HgtFieldValidator(int bit_position) : FieldValidator(bit_position) {
-    CHECK(pattern_.ok());
-  }
+// Matches `[[:digit:]]{9}`.
+bool PassportIdValid(absl::string_view value) {
+  return value.size() == 9 && AllDigits(value);
+}
 
- private:
-  bool IsValid(absl::string_view value) const override {
-    int height = 0;
-    std::string units;
-    if (!re2::RE2::FullMatch(value, pattern_, &height, &units)) return false;
-    if (units == "cm") {
-      return (150 <= height) && (height <= 193);
-    }
-    CHECK(units == "in");
-    return (59 <= height) && (height <= 76);
+// Returns the check bit for `field` if `value` is valid for it, or 0 if it is
+// not.
+std::uint8_t ValidateField(absl::string_view field, absl::string_view value) {
+  switch (PackKey(field)) {
+    case PackKey("byr"):
+      return IntInRange(value, 1920, 2002) << 0;
+    case PackKey("iyr"):
+      return IntInRange(value, 2010, 2020) << 1;
+    case PackKey("eyr"):
+      return IntInRange(value, 2020, 2030) << 2;
+    case PackKey("hgt"):
+      return HeightValid(value) << 3;
+    case PackKey("hcl"):
+      return HairColorValid(value) << 4;
+    case PackKey("ecl"):
+      return EyeColorValid(value) << 5;
+    case PackKey("pid"):
+      return PassportIdValid(value) << 6;
+    case PackKey("cid"):
+      return 1 << 7;
+    default:
+      CHECK_FAIL();
   }
-
-  re2::RE2 pattern_{"([[:digit:]]+)(cm|in)"};
-};
+}
 
 class PassportFields {
  public:
-  explicit PassportFields(absl::Span<const std::string> lines) {
-    for (const std::string& line : lines) {
-      if (line.empty()) continue;
-      for (absl::string_view field_value : absl::StrSplit(line, ' ')) {
-        const absl::string_view field = field_value.substr(0, 3);
-        CHECK(field_value[3] == ':');
-        const absl::string_view value = field_value.substr(4);
-        auto iter = validators_->find(field);
-        CHECK(iter != validators_->end());
-        rep_ |= iter->second->Validate(value);
-      }
-    }
+  void AddField(absl::string_view field, absl::string_view value) {
+    CHECK(field.size() == 3);
+    rep_ |= ValidateField(field, value);
   }
 
   bool IsValid() const {
@@ -114,36 +130,29 @@ class PassportFields {
     return (rep_ & kMask) == kMask;
   }
 
- private:
-  static const absl::flat_hash_map<std::string, FieldValidator*>* validators_;
+  void Clear() { rep_ = 0; }
 
+ private:
   std::uint8_t rep_ = 0;
 };
 
-const absl::flat_hash_map<std::string, FieldValidator*>*
-    PassportFields::validators_ =
-        new absl::flat_hash_map<std::string, FieldValidator*>{
-            {"byr", new IntFieldValidator(0, 1920, 2002)},
-            {"iyr", new IntFieldValidator(1, 2010, 2020)},
-            {"eyr", new IntFieldValidator(2, 2020, 2030)},
-            {"hgt", new HgtFieldValidator(3)},
-            {"hcl", new RegexFieldValidator(4, "#[[:xdigit:]]{6}")},
-            {"ecl", new RegexFieldValidator(5, "amb|blu|brn|gry|grn|hzl|oth")},
-            {"pid", new RegexFieldValidator(6, "[[:digit:]]{9}")},
-            {"cid", new NoopFieldValidator(7)}};
-
 }  // namespace
 
 int main(int argc, char** argv) {
   CHECK(argc == 2);
-  std::vector<std::string> lines = aoc2020::ReadLinesFromFile(argv[1]);
-  std::vector<std::vector<std::string>> passport_strs =
-      aoc2020::SplitByEmptyStrings(std::move(lines));
+  const std::string contents = aoc2020::ReadFile(argv[1]);
 
   int valid_passports = 0;
-  for (const std::vector<std::string> passport_desc : passport_strs) {
-    valid_passports += PassportFields(passport_desc).IsValid();
-  }
+  PassportFields passport;
+  aoc2020::day04::ScanPassports(
+      contents,
+      [&passport](absl::string_view field, absl::string_view value) {
+        passport.AddField(field, value);
+      },
+      [&passport, &valid_passports]() {
+        valid_passports += passport.IsValid();
+        passport.Clear();
+      });
   std::cout << valid_passports << "\n";
 
   return 0;
@@ -0,0 +1,50 @@
+#ifndef PUZZLES_DAY_04_PASSPORT_SCANNER_H_
+#define PUZZLES_DAY_04_PASSPORT_SCANNER_H_
+
+#include <algorithm>
+#include <cstddef>
+
+#include "absl/strings/string_view.h"
+#include "util/check.h"
+
+namespace aoc2020::day04 {
+
+// Walks the raw contents of a passport batch in a single pass without copying
+// anything. Calls `field_fn(key, value)` for every `key:value` token and
+// `record_fn()` at the end of each passport, where passports are separated by
+// one or more blank lines.
+template <typename FieldFn, typename RecordFn>
+void ScanPassports(absl::string_view buffer, FieldFn field_fn,
+                   RecordFn record_fn) {
+  bool in_record = false;
+  while (!buffer.empty()) {
+    std::size_t line_end = buffer.find('\n');
+    if (line_end == absl::string_view::npos) line_end = buffer.size();
+    absl::string_view line = buffer.substr(0, line_end);
+    buffer.remove_prefix(std::min(line_end + 1, buffer.size()));
+
+    if (line.empty()) {
+      if (in_record) record_fn();
+      in_record = false;
+      continue;
+    }
+
+    in_record = true;
+    while (!line.empty()) {
+      std::size_t token_end = line.find(' ');
+      if (token_end == absl::string_view::npos) token_end = line.size();
+      const absl::string_view token = line.substr(0, token_end);
+      line.remove_prefix(std::min(token_end + 1, line.size()));
+      if (token.empty()) continue;
+
+      const std::size_t colon = token.find(':');
+      CHECK(colon != absl::string_view::npos);
+      field_fn(token.substr(0, colon), token.substr(colon + 1));
+    }
+  }
+  if (in_record) record_fn();
+}
+
+}  // namespace aoc2020::day04
+
+#endif  // PUZZLES_DAY_04_PASSPORT_SCANNER_H_
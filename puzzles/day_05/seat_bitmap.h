@@ -0,0 +1,69 @@
+#ifndef PUZZLES_DAY_05_SEAT_BITMAP_H_
+#define PUZZLES_DAY_05_SEAT_BITMAP_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/types/optional.h"
+#include "util/check.h"
+
+namespace aoc2020::day05 {
+
+// Fixed-size occupancy bitmap for seat IDs that are `kCodeBits` wide (a
+// 10-character boarding pass is 10 bits, for 1024 seats).
+template <std::size_t kCodeBits>
+class SeatBitmap {
+ public:
+  static inline constexpr std::size_t kSeats = std::size_t{1} << kCodeBits;
+
+  void Insert(const unsigned seat) {
+    CHECK(seat < kSeats);
+    words_[seat >> kHighShift] |= std::uint64_t{1} << (seat & kLowMask);
+  }
+
+  bool Contains(const unsigned seat) const {
+    return (words_[seat >> kHighShift] >> (seat & kLowMask)) & 1;
+  }
+
+  // Returns the highest occupied seat. The bitmap must not be empty.
+  unsigned MaxSeat() const {
+    for (std::size_t idx = kWords; idx-- > 0;) {
+      if (words_[idx] != 0) {
+        return (idx << kHighShift) + kLowMask - __builtin_clzll(words_[idx]);
+      }
+    }
+    CHECK_FAIL();
+  }
+
+  // Returns the first unoccupied seat after the lowest occupied one, as long
+  // as there is some occupied seat after it too.
+  absl::optional<unsigned> FindGap() const {
+    std::size_t idx = 0;
+    while (idx < kWords && words_[idx] == 0) ++idx;
+    if (idx == kWords) return absl::nullopt;
+
+    // Fill in everything below the lowest occupied seat so that the first
+    // zero bit in the word is the gap (if it is in this word at all).
+    std::uint64_t word = words_[idx] | (words_[idx] - 1);
+    while (word == ~std::uint64_t{0}) {
+      if (++idx == kWords) return absl::nullopt;
+      word = words_[idx];
+    }
+    const unsigned gap = (idx << kHighShift) + __builtin_ctzll(~word);
+    if (gap > MaxSeat()) return absl::nullopt;
+    return gap;
+  }
+
+ private:
+  static inline constexpr std::size_t kHighShift = 6;
+  static inline constexpr std::size_t kLowMask = 63;
+  static inline constexpr std::size_t kWords =
+      (kSeats + kLowMask) >> kHighShift;
+
+  std::array<std::uint64_t, kWords> words_ = {};
+};
+
+}  // namespace aoc2020::day05
+
+#endif  // PUZZLES_DAY_05_SEAT_BITMAP_H_
@@ -0,0 +1,101 @@
+#include "puzzles/day_05/seat_decoder.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_SSSE3_DECODER 1
+#else
+#define HAVE_SSSE3_DECODER 0
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "absl/strings/string_view.h"
+#include "puzzles/day_05/seat_bitmap.h"
+#include "util/check.h"
+
+namespace aoc2020::day05 {
+namespace {
+
+constexpr std::size_t kSeatChars = 10;
+
+using DecodeFn = unsigned (*)(const char* seat);
+
+unsigned DecodeSeatScalar(const char* seat) {
+  unsigned val = 0;
+  for (std::size_t i = 0; i < kSeatChars; ++i) {
+    val <<= 1;
+    switch (seat[i]) {
+      case 'F':
+      case 'L':
+        val |= 0;
+        break;
+      case 'B':
+      case 'R':
+        val |= 1;
+        break;
+      default:
+        CHECK_FAIL();
+    }
+  }
+  return val;
+}
+
+#if HAVE_SSSE3_DECODER
+
+// Loads exactly the 10 characters of `seat` into one vector, reverses them so
+// that the last character lands in the lowest lane, and turns "is B or R" into
+// the seat ID with a single movemask.
+__attribute__((target("ssse3"))) unsigned DecodeSeatSsse3(const char* seat) {
+  std::uint64_t head = 0;
+  std::uint16_t tail = 0;
+  std::memcpy(&head, seat, sizeof(head));
+  std::memcpy(&tail, seat + sizeof(head), sizeof(tail));
+  __m128i chars = _mm_insert_epi16(
+      _mm_cvtsi64_si128(static_cast<long long>(head)), tail, 4);
+  chars = _mm_shuffle_epi8(
+      chars, _mm_setr_epi8(9, 8, 7, 6, 5, 4, 3, 2, 1, 0, -1, -1, -1, -1, -1,
+                           -1));
+
+  const __m128i ones =
+      _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('B')),
+                   _mm_cmpeq_epi8(chars, _mm_set1_epi8('R')));
+  const __m128i zeros =
+      _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('F')),
+                   _mm_cmpeq_epi8(chars, _mm_set1_epi8('L')));
+  const unsigned one_bits = _mm_movemask_epi8(ones);
+  const unsigned zero_bits = _mm_movemask_epi8(zeros);
+  CHECK((one_bits | zero_bits) == (1u << kSeatChars) - 1);
+  return one_bits;
+}
+
+#endif  // HAVE_SSSE3_DECODER
+
+DecodeFn SelectDecoder() {
+#if HAVE_SSSE3_DECODER
+  if (__builtin_cpu_supports("ssse3")) return &DecodeSeatSsse3;
+#endif
+  return &DecodeSeatScalar;
+}
+
+DecodeFn Decoder() {
+  static const DecodeFn decoder = SelectDecoder();
+  return decoder;
+}
+
+}  // namespace
+
+void DecodeSeats(absl::string_view contents, SeatBitmap<10>* occupied) {
+  const DecodeFn decoder = Decoder();
+  while (!contents.empty()) {
+    std::size_t line_end = contents.find('\n');
+    if (line_end == absl::string_view::npos) line_end = contents.size();
+    CHECK(line_end == kSeatChars);
+    occupied->Insert(decoder(contents.data()));
+    contents.remove_prefix(
+        line_end == contents.size() ? line_end : line_end + 1);
+  }
+}
+
+}  // namespace aoc2020::day05
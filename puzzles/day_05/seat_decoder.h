@@ -0,0 +1,15 @@
+#ifndef PUZZLES_DAY_05_SEAT_DECODER_H_
+#define PUZZLES_DAY_05_SEAT_DECODER_H_
+
+#include "absl/strings/string_view.h"
+#include "puzzles/day_05/seat_bitmap.h"
+
+namespace aoc2020::day05 {
+
+// Decodes every newline-separated 10-character boarding pass (like
+// "FBFBBFFRLR") in `contents`, marking each seat ID as occupied in `occupied`.
+void DecodeSeats(absl::string_view contents, SeatBitmap<10>* occupied);
+
+}  // namespace aoc2020::day05
+
+#endif  // PUZZLES_DAY_05_SEAT_DECODER_H_
@@ -0,0 +1,94 @@
+#include "puzzles/day_06/answer_aggregator.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "absl/strings/string_view.h"
+
+namespace aoc2020::day06 {
+namespace {
+
+std::uint32_t ScalarLineMask(absl::string_view line) {
+  std::uint32_t mask = 0;
+  for (const char c : line) {
+    mask |= (1 << (c - 'a'));
+  }
+  return mask;
+}
+
+#if defined(__AVX2__)
+
+// Converts the answers on a line to a bitmask 8 characters at a time: each
+// character is widened to a 32-bit lane, turned into a single bit with a
+// variable shift, and the lanes are OR-ed together at the end.
+std::uint32_t LineMask(absl::string_view line) {
+  const __m256i letter_a = _mm256_set1_epi32('a');
+  const __m256i one = _mm256_set1_epi32(1);
+  __m256i bits = _mm256_setzero_si256();
+  while (line.size() >= 8) {
+    const __m256i chars = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(line.data())));
+    bits = _mm256_or_si256(
+        bits, _mm256_sllv_epi32(one, _mm256_sub_epi32(chars, letter_a)));
+    line.remove_prefix(8);
+  }
+
+  __m128i reduced = _mm_or_si128(_mm256_castsi256_si128(bits),
+                                 _mm256_extracti128_si256(bits, 1));
+  reduced = _mm_or_si128(reduced, _mm_unpackhi_epi64(reduced, reduced));
+  reduced = _mm_or_si128(reduced, _mm_srli_epi64(reduced, 32));
+  return static_cast<std::uint32_t>(_mm_cvtsi128_si32(reduced)) |
+         ScalarLineMask(line);
+}
+
+#else
+
+std::uint32_t LineMask(absl::string_view line) { return ScalarLineMask(line); }
+
+#endif  // __AVX2__
+
+}  // namespace
+
+AnswerTotals AggregateAnswers(absl::string_view contents) {
+  AnswerTotals totals;
+  bool in_group = false;
+  std::uint32_t any_yes = 0;
+  std::uint32_t all_yes = std::numeric_limits<std::uint32_t>::max();
+  auto finish_group = [&]() {
+    if (in_group) {
+      totals.any_yes += __builtin_popcount(any_yes);
+      totals.all_yes += __builtin_popcount(all_yes);
+    }
+    in_group = false;
+    any_yes = 0;
+    all_yes = std::numeric_limits<std::uint32_t>::max();
+  };
+
+  while (!contents.empty()) {
+    std::size_t line_end = contents.find('\n');
+    if (line_end == absl::string_view::npos) line_end = contents.size();
+    const absl::string_view line = contents.substr(0, line_end);
+    contents.remove_prefix(std::min(line_end + 1, contents.size()));
+
+    if (line.empty()) {
+      finish_group();
+      continue;
+    }
+
+    const std::uint32_t person = LineMask(line);
+    any_yes |= person;
+    all_yes &= person;
+    in_group = true;
+  }
+  finish_group();
+
+  return totals;
+}
+
+}  // namespace aoc2020::day06
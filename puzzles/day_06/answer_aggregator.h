@@ -0,0 +1,21 @@
+#ifndef PUZZLES_DAY_06_ANSWER_AGGREGATOR_H_
+#define PUZZLES_DAY_06_ANSWER_AGGREGATOR_H_
+
+#include "absl/strings/string_view.h"
+
+namespace aoc2020::day06 {
+
+struct AnswerTotals {
+  // Sum over groups of the questions anyone in the group answered "yes" to.
+  int any_yes = 0;
+  // Sum over groups of the questions everyone in the group answered "yes" to.
+  int all_yes = 0;
+};
+
+// Computes both totals in a single pass over `contents`, where each line is
+// one person's answers and groups are separated by blank lines.
+AnswerTotals AggregateAnswers(absl::string_view contents);
+
+}  // namespace aoc2020::day06
+
+#endif  // PUZZLES_DAY_06_ANSWER_AGGREGATOR_H_
@@ -0,0 +1,158 @@
+#include "puzzles/day_07/bag_graph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "puzzles/day_07/rule_parser.h"
+#include "util/check.h"
+
+namespace aoc2020 {
+namespace {
+
+struct Edge {
+  int from = 0;
+  int to = 0;
+  int count = 0;
+};
+
+}  // namespace
+
+std::int64_t AddHeldBags(const std::int64_t total, const int count,
+                         const std::int64_t held) {
+  std::int64_t with_self = 0;
+  std::int64_t product = 0;
+  std::int64_t sum = 0;
+  if (__builtin_add_overflow(held, 1, &with_self) ||
+      __builtin_mul_overflow(with_self, count, &product) ||
+      __builtin_add_overflow(total, product, &sum)) {
+    return BagGraph::kSaturatedCount;
+  }
+  return sum;
+}
+
+BagGraph::BagGraph(absl::Span<const BagRule> rules) {
+  std::vector<Edge> edges;
+  std::vector<bool> has_rule;
+  for (const BagRule& rule : rules) {
+    const int container = Intern(rule.container_color);
+    has_rule.resize(ids_.size(), false);
+    CHECK(!has_rule[container]);
+    has_rule[container] = true;
+    for (const ContainedBags& contained : rule.contained_bags) {
+      edges.push_back(Edge{.from = container,
+                           .to = Intern(contained.color),
+                           .count = contained.count});
+    }
+  }
+
+  const std::size_t num_nodes = ids_.size();
+  contains_.offsets.assign(num_nodes + 1, 0);
+  contained_by_.offsets.assign(num_nodes + 1, 0);
+  for (const Edge& edge : edges) {
+    ++contains_.offsets[edge.from + 1];
+    ++contained_by_.offsets[edge.to + 1];
+  }
+  for (std::size_t node = 0; node < num_nodes; ++node) {
+    contains_.offsets[node + 1] += contains_.offsets[node];
+    contained_by_.offsets[node + 1] += contained_by_.offsets[node];
+  }
+
+  for (Adjacency* adjacency : {&contains_, &contained_by_}) {
+    adjacency->targets.resize(edges.size());
+    adjacency->counts.resize(edges.size());
+  }
+  std::vector<int> contains_fill(contains_.offsets.begin(),
+                                 contains_.offsets.end() - 1);
+  std::vector<int> contained_by_fill(contained_by_.offsets.begin(),
+                                     contained_by_.offsets.end() - 1);
+  for (const Edge& edge : edges) {
+    const int forward = contains_fill[edge.from]++;
+    contains_.targets[forward] = edge.to;
+    contains_.counts[forward] = edge.count;
+
+    const int reverse = contained_by_fill[edge.to]++;
+    contained_by_.targets[reverse] = edge.from;
+    contained_by_.counts[reverse] = edge.count;
+  }
+
+  ComputeHeldCounts();
+}
+
+int BagGraph::Intern(absl::string_view color) {
+  return ids_.try_emplace(color, ids_.size()).first->second;
+}
+
+int BagGraph::FindId(absl::string_view color) const {
+  auto iter = ids_.find(color);
+  CHECK(iter != ids_.end());
+  return iter->second;
+}
+
+int BagGraph::CountOutermostBags(absl::string_view bag_color) const {
+  const int start = FindId(bag_color);
+  std::vector<std::uint64_t> visited((ids_.size() + 63) / 64, 0);
+  visited[start >> 6] |= std::uint64_t{1} << (start & 63);
+
+  int outermost_bags = 0;
+  std::vector<int> unprocessed_bags = {start};
+  while (!unprocessed_bags.empty()) {
+    const int current_bag = unprocessed_bags.back();
+    unprocessed_bags.pop_back();
+    for (int edge = contained_by_.offsets[current_bag];
+         edge < contained_by_.offsets[current_bag + 1]; ++edge) {
+      const int container = contained_by_.targets[edge];
+      std::uint64_t& word = visited[container >> 6];
+      const std::uint64_t bit = std::uint64_t{1} << (container & 63);
+      if (word & bit) continue;
+      word |= bit;
+      ++outermost_bags;
+      unprocessed_bags.push_back(container);
+    }
+  }
+  return outermost_bags;
+}
+
+std::int64_t BagGraph::CountHeldBags(absl::string_view bag_color) const {
+  const std::int64_t held = held_counts_[FindId(bag_color)];
+  CHECK(held >= 0);
+  return held;
+}
+
+void BagGraph::ComputeHeldCounts() {
+  const std::size_t num_nodes = ids_.size();
+  held_counts_.assign(num_nodes, -1);
+
+  // A color is ready once every color it directly holds has been evaluated.
+  std::vector<int> unevaluated_held(num_nodes, 0);
+  std::vector<int> ready;
+  for (std::size_t node = 0; node < num_nodes; ++node) {
+    unevaluated_held[node] =
+        contains_.offsets[node + 1] - contains_.offsets[node];
+    if (unevaluated_held[node] == 0) ready.push_back(node);
+  }
+
+  while (!ready.empty()) {
+    const int node = ready.back();
+    ready.pop_back();
+
+    std::int64_t total_bags = 0;
+    for (int edge = contains_.offsets[node]; edge < contains_.offsets[node + 1];
+         ++edge) {
+      total_bags = AddHeldBags(total_bags, contains_.counts[edge],
+                               held_counts_[contains_.targets[edge]]);
+    }
+    held_counts_[node] = total_bags;
+
+    for (int edge = contained_by_.offsets[node];
+         edge < contained_by_.offsets[node + 1]; ++edge) {
+      const int container = contained_by_.targets[edge];
+      if (--unevaluated_held[container] == 0) ready.push_back(container);
+    }
+  }
+}
+
+}  // namespace aoc2020
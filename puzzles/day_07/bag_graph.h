@@ -0,0 +1,71 @@
+#ifndef PUZZLES_DAY_07_BAG_GRAPH_H_
+#define PUZZLES_DAY_07_BAG_GRAPH_H_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "puzzles/day_07/rule_parser.h"
+
+namespace aoc2020 {
+
+// An immutable graph of which bags hold which others. Colors are interned to
+// dense integer ids, and both the "contains" edges and the reverse
+// "contained by" edges are stored in compressed sparse row form. The number of
+// bags held inside every color is computed once, up front, so that
+// CountHeldBags() is a constant-time lookup.
+class BagGraph {
+ public:
+  // Each color may be the container of at most one rule; a second rule for the
+  // same container CHECK-fails.
+  explicit BagGraph(absl::Span<const BagRule> rules);
+
+  // Returns the number of distinct bag colors that can eventually contain a
+  // bag of `bag_color`.
+  int CountOutermostBags(absl::string_view bag_color) const;
+
+  // Returns the total number of bags held (directly or indirectly) inside a
+  // single bag of `bag_color`. Totals too large for an int64_t saturate at
+  // kSaturatedCount. It is an error to call this for a color that can
+  // (eventually) contain itself.
+  std::int64_t CountHeldBags(absl::string_view bag_color) const;
+
+  static inline constexpr std::int64_t kSaturatedCount =
+      std::numeric_limits<std::int64_t>::max();
+
+ private:
+  // Compressed sparse row adjacency: the edges out of node `n` are
+  // `targets[offsets[n]]` through `targets[offsets[n + 1] - 1]`, with
+  // matching `counts`.
+  struct Adjacency {
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<int> counts;
+  };
+
+  int Intern(absl::string_view color);
+  int FindId(absl::string_view color) const;
+
+  // Fills in `held_counts_` for every color, visiting colors in reverse
+  // topological order so each is evaluated exactly once.
+  void ComputeHeldCounts();
+
+  absl::flat_hash_map<std::string, int> ids_;
+  Adjacency contains_;
+  Adjacency contained_by_;
+  // Indexed by id. Colors that are part of a cycle are left at -1.
+  std::vector<std::int64_t> held_counts_;
+};
+
+// Returns `total + count * (1 + held)`: the running total of bags inside some
+// bag after adding `count` bags that each hold `held` more. Saturates at
+// BagGraph::kSaturatedCount instead of overflowing.
+std::int64_t AddHeldBags(std::int64_t total, int count, std::int64_t held);
+
+}  // namespace aoc2020
+
+#endif  // PUZZLES_DAY_07_BAG_GRAPH_H_
@@ -0,0 +1,93 @@
+// Times BagGraph::CountHeldBags() against the unmemoized recursion it
+// replaced, on a generated "deep diamond": every level has two colors, each
+// holding one bag of both colors on the next level, so the recursion visits
+// 2^depth paths. Usage: diamond_bench [depth]. The recursion is skipped for
+// depths above kMaxRecursiveDepth.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "puzzles/day_07/bag_graph.h"
+#include "puzzles/day_07/rule_parser.h"
+#include "util/check.h"
+
+namespace {
+
+constexpr int kMaxRecursiveDepth = 30;
+
+std::vector<std::string> DiamondRules(const int depth) {
+  std::vector<std::string> lines;
+  for (int level = 0; level < depth; ++level) {
+    for (const char* side : {"left", "right"}) {
+      lines.push_back(absl::StrCat(side, " ", level, " bags contain 1 left ",
+                                   level + 1, " bag, 1 right ", level + 1,
+                                   " bag."));
+    }
+  }
+  for (const char* side : {"left", "right"}) {
+    lines.push_back(
+        absl::StrCat(side, " ", depth, " bags contain no other bags."));
+  }
+  return lines;
+}
+
+// The baseline part 2 evaluation: one recursive call per path.
+std::int64_t CountHeldBagsRecursively(
+    const absl::flat_hash_map<absl::string_view,
+                              std::vector<aoc2020::ContainedBags>>& contains,
+    absl::string_view bag_color) {
+  std::int64_t total_bags = 0;
+  for (const aoc2020::ContainedBags& held : contains.at(bag_color)) {
+    total_bags +=
+        held.count * (1 + CountHeldBagsRecursively(contains, held.color));
+  }
+  return total_bags;
+}
+
+double MillisecondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CHECK(argc <= 2);
+  int depth = 22;
+  if (argc >= 2) CHECK(absl::SimpleAtoi(argv[1], &depth));
+  CHECK(depth > 0);
+
+  const std::vector<std::string> lines = DiamondRules(depth);
+  std::vector<aoc2020::BagRule> rules;
+  rules.reserve(lines.size());
+  for (const absl::string_view line : lines) {
+    rules.push_back(aoc2020::ParseBagRule(line));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  const aoc2020::BagGraph graph(rules);
+  const std::int64_t memoized = graph.CountHeldBags("left 0");
+  std::cout << "depth " << depth << ": memoized " << memoized << " in "
+            << MillisecondsSince(start) << " ms\n";
+
+  if (depth > kMaxRecursiveDepth) return 0;
+  absl::flat_hash_map<absl::string_view, std::vector<aoc2020::ContainedBags>>
+      contains;
+  for (const aoc2020::BagRule& rule : rules) {
+    contains[rule.container_color] = rule.contained_bags;
+  }
+  start = std::chrono::steady_clock::now();
+  const std::int64_t recursive = CountHeldBagsRecursively(contains, "left 0");
+  std::cout << "depth " << depth << ": recursive " << recursive << " in "
+            << MillisecondsSince(start) << " ms\n";
+  CHECK(recursive == memoized);
+  return 0;
+}
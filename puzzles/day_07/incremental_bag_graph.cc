@@ -0,0 +1,210 @@
+#include "puzzles/day_07/incremental_bag_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "puzzles/day_07/bag_graph.h"
+#include "puzzles/day_07/rule_parser.h"
+#include "util/check.h"
+
+namespace aoc2020 {
+
+void IncrementalBagGraph::AddRule(const BagRule& rule) {
+  // Intern everything first, since interning may reallocate `nodes_`.
+  const int container = Intern(rule.container_color);
+  std::vector<HeldEdge> contains;
+  contains.reserve(rule.contained_bags.size());
+  for (const ContainedBags& contained : rule.contained_bags) {
+    contains.push_back(
+        HeldEdge{.id = Intern(contained.color), .count = contained.count});
+  }
+  CHECK(!nodes_[container].has_rule);
+
+  std::vector<int> held_ids;
+  held_ids.reserve(contains.size());
+  for (const HeldEdge& edge : contains) {
+    held_ids.push_back(edge.id);
+  }
+  // A cycle through the new rule needs an edge into `container`, either an
+  // existing one or one in the rule itself.
+  if (!nodes_[container].contained_by.empty() ||
+      std::find(held_ids.begin(), held_ids.end(), container) !=
+          held_ids.end()) {
+    CHECK(!CanReach(held_ids, container));
+  }
+
+  InvalidateOutermostBags(held_ids);
+  InvalidateHeldCounts(container);
+
+  for (const HeldEdge& edge : contains) {
+    nodes_[edge.id].contained_by.push_back(container);
+  }
+  nodes_[container].has_rule = true;
+  nodes_[container].contains = std::move(contains);
+}
+
+void IncrementalBagGraph::RemoveRule(absl::string_view container_color) {
+  const int container = FindId(container_color);
+  Node& node = nodes_[container];
+  CHECK(node.has_rule);
+
+  std::vector<int> held_ids;
+  held_ids.reserve(node.contains.size());
+  for (const HeldEdge& edge : node.contains) {
+    held_ids.push_back(edge.id);
+  }
+  InvalidateOutermostBags(held_ids);
+  InvalidateHeldCounts(container);
+
+  for (const int held : held_ids) {
+    std::vector<int>& contained_by = nodes_[held].contained_by;
+    auto iter = std::find(contained_by.begin(), contained_by.end(), container);
+    CHECK(iter != contained_by.end());
+    *iter = contained_by.back();
+    contained_by.pop_back();
+  }
+  node.has_rule = false;
+  node.contains.clear();
+}
+
+int IncrementalBagGraph::CountOutermostBags(absl::string_view bag_color) {
+  return OutermostBags(FindId(bag_color));
+}
+
+std::int64_t IncrementalBagGraph::CountHeldBags(absl::string_view bag_color) {
+  return HeldCount(FindId(bag_color));
+}
+
+int IncrementalBagGraph::Intern(absl::string_view color) {
+  auto [iter, inserted] = ids_.try_emplace(color, nodes_.size());
+  if (inserted) nodes_.emplace_back();
+  return iter->second;
+}
+
+int IncrementalBagGraph::FindId(absl::string_view color) const {
+  auto iter = ids_.find(color);
+  CHECK(iter != ids_.end());
+  return iter->second;
+}
+
+bool IncrementalBagGraph::CanReach(const std::vector<int>& from,
+                                   const int target) {
+  visited_.NextEpoch(nodes_.size());
+  std::vector<int> unprocessed;
+  for (const int id : from) {
+    if (visited_.IsMarked(id)) continue;
+    visited_.Mark(id);
+    unprocessed.push_back(id);
+  }
+  while (!unprocessed.empty()) {
+    const int id = unprocessed.back();
+    unprocessed.pop_back();
+    if (id == target) return true;
+    for (const HeldEdge& edge : nodes_[id].contains) {
+      if (visited_.IsMarked(edge.id)) continue;
+      visited_.Mark(edge.id);
+      unprocessed.push_back(edge.id);
+    }
+  }
+  return false;
+}
+
+int IncrementalBagGraph::OutermostBags(const int id) {
+  Node& node = nodes_[id];
+  if (node.outermost_bags != kStale) return node.outermost_bags;
+
+  visited_.NextEpoch(nodes_.size());
+  visited_.Mark(id);
+  int outermost_bags = 0;
+  std::vector<int> unprocessed = {id};
+  while (!unprocessed.empty()) {
+    const int current = unprocessed.back();
+    unprocessed.pop_back();
+    for (const int container : nodes_[current].contained_by) {
+      if (visited_.IsMarked(container)) continue;
+      visited_.Mark(container);
+      ++outermost_bags;
+      unprocessed.push_back(container);
+    }
+  }
+  node.outermost_bags = outermost_bags;
+  ++num_cached_outermost_;
+  return outermost_bags;
+}
+
+std::int64_t IncrementalBagGraph::HeldCount(const int id) {
+  // Post-order over "contains" edges with an explicit stack, since
+  // containment chains can be far deeper than the call stack allows. A color
+  // is expanded (its stale children pushed) the first time it is seen and
+  // evaluated the second, once every color inside it is valid.
+  std::vector<std::pair<int, bool>> unprocessed = {{id, false}};
+  while (!unprocessed.empty()) {
+    auto [current, expanded] = unprocessed.back();
+    Node& node = nodes_[current];
+    if (node.held_count != kStale) {
+      unprocessed.pop_back();
+      continue;
+    }
+    if (!expanded) {
+      unprocessed.back().second = true;
+      for (const HeldEdge& edge : node.contains) {
+        if (nodes_[edge.id].held_count == kStale) {
+          unprocessed.emplace_back(edge.id, false);
+        }
+      }
+      continue;
+    }
+    unprocessed.pop_back();
+
+    std::int64_t total_bags = 0;
+    for (const HeldEdge& edge : node.contains) {
+      total_bags =
+          AddHeldBags(total_bags, edge.count, nodes_[edge.id].held_count);
+    }
+    node.held_count = total_bags;
+  }
+  return nodes_[id].held_count;
+}
+
+void IncrementalBagGraph::InvalidateHeldCounts(const int id) {
+  nodes_[id].held_count = kStale;
+  std::vector<int> unprocessed(nodes_[id].contained_by);
+  while (!unprocessed.empty()) {
+    Node& node = nodes_[unprocessed.back()];
+    unprocessed.pop_back();
+    if (node.held_count == kStale) continue;
+    node.held_count = kStale;
+    unprocessed.insert(unprocessed.end(), node.contained_by.begin(),
+                       node.contained_by.end());
+  }
+}
+
+void IncrementalBagGraph::InvalidateOutermostBags(
+    const std::vector<int>& ids) {
+  if (num_cached_outermost_ == 0) return;
+  visited_.NextEpoch(nodes_.size());
+  std::vector<int> unprocessed;
+  for (const int id : ids) {
+    if (visited_.IsMarked(id)) continue;
+    visited_.Mark(id);
+    unprocessed.push_back(id);
+  }
+  while (!unprocessed.empty() && num_cached_outermost_ > 0) {
+    Node& node = nodes_[unprocessed.back()];
+    unprocessed.pop_back();
+    if (node.outermost_bags != kStale) {
+      node.outermost_bags = kStale;
+      --num_cached_outermost_;
+    }
+    for (const HeldEdge& edge : node.contains) {
+      if (visited_.IsMarked(edge.id)) continue;
+      visited_.Mark(edge.id);
+      unprocessed.push_back(edge.id);
+    }
+  }
+}
+
+}  // namespace aoc2020
@@ -0,0 +1,85 @@
+#ifndef PUZZLES_DAY_07_INCREMENTAL_BAG_GRAPH_H_
+#define PUZZLES_DAY_07_INCREMENTAL_BAG_GRAPH_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "puzzles/day_07/rule_parser.h"
+#include "util/epoch_marks.h"
+
+namespace aoc2020 {
+
+// A bag graph that supports adding and removing rules between queries. The
+// answers to CountOutermostBags() and CountHeldBags() are cached per color and
+// computed lazily; a rule change only invalidates the caches of the colors
+// whose answers it can actually affect (the descendants of the changed rule
+// for outermost counts, and its ancestors for held counts).
+class IncrementalBagGraph {
+ public:
+  // Adds the rule for `rule.container_color`, which must not currently have
+  // one. It is an error for the rule to let a bag (eventually) contain itself.
+  void AddRule(const BagRule& rule);
+
+  // Removes the rule for `container_color`, which must currently have one.
+  void RemoveRule(absl::string_view container_color);
+
+  // Returns the number of distinct bag colors that can eventually contain a
+  // bag of `bag_color`.
+  int CountOutermostBags(absl::string_view bag_color);
+
+  // Returns the total number of bags held (directly or indirectly) inside a
+  // single bag of `bag_color`, saturating like BagGraph::CountHeldBags().
+  std::int64_t CountHeldBags(absl::string_view bag_color);
+
+ private:
+  struct HeldEdge {
+    int id = 0;
+    int count = 0;
+  };
+
+  struct Node {
+    bool has_rule = false;
+    std::vector<HeldEdge> contains;
+    // One entry per edge, so a container holding this color under two
+    // different counts appears twice.
+    std::vector<int> contained_by;
+
+    // Cached answers. A valid `held_count` implies valid held counts for
+    // every descendant, which lets invalidation stop at already-stale colors.
+    // `outermost_bags` is only cached for colors that were queried, so its
+    // invalidation has to visit the whole affected subgraph.
+    std::int64_t held_count = kStale;
+    int outermost_bags = kStale;
+  };
+
+  static inline constexpr std::int64_t kStale = -1;
+
+  int Intern(absl::string_view color);
+  int FindId(absl::string_view color) const;
+
+  // Returns whether `target` is one of `from` or can be reached from them by
+  // following "contains" edges. Touches no caches.
+  bool CanReach(const std::vector<int>& from, int target);
+
+  int OutermostBags(int id);
+  std::int64_t HeldCount(int id);
+
+  // Marks the held counts of `id` and everything that can contain it stale.
+  void InvalidateHeldCounts(int id);
+  // Marks the outermost counts of `ids` and everything they can contain
+  // stale.
+  void InvalidateOutermostBags(const std::vector<int>& ids);
+
+  absl::flat_hash_map<std::string, int> ids_;
+  std::vector<Node> nodes_;
+  // Number of nodes with a valid `outermost_bags`.
+  int num_cached_outermost_ = 0;
+  EpochMarks visited_;
+};
+
+}  // namespace aoc2020
+
+#endif  // PUZZLES_DAY_07_INCREMENTAL_BAG_GRAPH_H_
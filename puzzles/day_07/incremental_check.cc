@@ -0,0 +1,103 @@
+// Cross-checks IncrementalBagGraph against a BagGraph rebuilt from scratch
+// after every change, over random sequences of rule additions and removals.
+// Usage: incremental_check [num_steps [seed]]. Prints the first disagreement
+// and exits nonzero if the two ever differ.
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "puzzles/day_07/bag_graph.h"
+#include "puzzles/day_07/incremental_bag_graph.h"
+#include "puzzles/day_07/rule_parser.h"
+#include "util/check.h"
+
+namespace {
+
+using aoc2020::BagGraph;
+using aoc2020::BagRule;
+using aoc2020::ContainedBags;
+using aoc2020::IncrementalBagGraph;
+
+constexpr int kNumColors = 60;
+
+// Generates one candidate rule per color. A color only ever holds colors with
+// a higher index, so any subset of the rules is acyclic.
+std::vector<BagRule> RandomRules(const std::vector<std::string>& colors,
+                                 std::mt19937& rng) {
+  std::vector<BagRule> rules(colors.size());
+  for (std::size_t container = 0; container < colors.size(); ++container) {
+    rules[container].container_color = colors[container];
+    for (std::size_t held = container + 1; held < colors.size(); ++held) {
+      if (rng() % 8 != 0) continue;
+      rules[container].contained_bags.push_back(ContainedBags{
+          .color = colors[held], .count = static_cast<int>(1 + rng() % 5)});
+    }
+  }
+  return rules;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CHECK(argc <= 3);
+  int num_steps = 5000;
+  std::uint32_t seed = 1;
+  if (argc >= 2) CHECK(absl::SimpleAtoi(argv[1], &num_steps));
+  if (argc >= 3) CHECK(absl::SimpleAtoi(argv[2], &seed));
+
+  std::mt19937 rng(seed);
+  std::vector<std::string> colors;
+  for (int idx = 0; idx < kNumColors; ++idx) {
+    colors.push_back("color " + std::to_string(idx));
+  }
+  const std::vector<BagRule> rules = RandomRules(colors, rng);
+
+  IncrementalBagGraph incremental;
+  std::vector<bool> present(rules.size(), false);
+  for (int step = 0; step < num_steps; ++step) {
+    const std::size_t changed = rng() % rules.size();
+    if (present[changed]) {
+      incremental.RemoveRule(rules[changed].container_color);
+    } else {
+      incremental.AddRule(rules[changed]);
+    }
+    present[changed] = !present[changed];
+
+    // Only colors with a rule are certain to be known to both graphs.
+    std::vector<BagRule> current;
+    for (std::size_t idx = 0; idx < rules.size(); ++idx) {
+      if (present[idx]) current.push_back(rules[idx]);
+    }
+    if (current.empty()) continue;
+    const BagGraph rebuilt(current);
+    for (int query = 0; query < 3; ++query) {
+      const BagRule& rule = current[rng() % current.size()];
+      const int expected_outermost =
+          rebuilt.CountOutermostBags(rule.container_color);
+      const int actual_outermost =
+          incremental.CountOutermostBags(rule.container_color);
+      const std::int64_t expected_held =
+          rebuilt.CountHeldBags(rule.container_color);
+      const std::int64_t actual_held =
+          incremental.CountHeldBags(rule.container_color);
+      if (expected_outermost == actual_outermost &&
+          expected_held == actual_held) {
+        continue;
+      }
+      std::cout << "Mismatch at step " << step << " for "
+                << rule.container_color
+                << ": rebuilt outermost=" << expected_outermost
+                << " held=" << expected_held
+                << ", incremental outermost=" << actual_outermost
+                << " held=" << actual_held << "\n";
+      return 1;
+    }
+  }
+
+  std::cout << num_steps << " steps matched\n";
+  return 0;
+}
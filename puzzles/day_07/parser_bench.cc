@@ -0,0 +1,136 @@
+// Times ParseBagRule() against the RE2 parser it replaced, on generated rules,
+// and checks that both produce the same BagRules. Usage:
+// parser_bench [num_rules [seed]].
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "puzzles/day_07/rule_parser.h"
+#include "re2/re2.h"
+#include "re2/stringpiece.h"
+#include "util/check.h"
+
+namespace {
+
+using aoc2020::BagRule;
+using aoc2020::ContainedBags;
+
+std::string Color(const int id) {
+  return absl::StrCat("shade", id % 997, " hue", id / 997);
+}
+
+// Rule `id` holds up to four colors with higher ids, so the rules form a DAG
+// as the puzzle's do.
+std::vector<std::string> RandomRules(const int num_rules, std::mt19937& rng) {
+  std::vector<std::string> lines;
+  lines.reserve(num_rules);
+  for (int id = 0; id < num_rules; ++id) {
+    std::string line = absl::StrCat(Color(id), " bags contain ");
+    const int num_held = id + 1 < num_rules ? rng() % 5 : 0;
+    if (num_held == 0) absl::StrAppend(&line, "no other bags.");
+    for (int held = 0; held < num_held; ++held) {
+      const int count = 1 + rng() % 6;
+      const int held_id = id + 1 + rng() % (num_rules - id - 1);
+      absl::StrAppend(&line, count, " ", Color(held_id),
+                      count == 1 ? " bag" : " bags",
+                      held + 1 == num_held ? "." : ", ");
+    }
+    lines.push_back(std::move(line));
+  }
+  return lines;
+}
+
+absl::string_view ToStringView(re2::StringPiece sp) {
+  return absl::string_view(sp.data(), sp.size());
+}
+
+// The baseline parser.
+BagRule ParseBagRuleWithRe2(absl::string_view rule_txt) {
+  static re2::LazyRE2 kContainerMatcher = {"(.*?) bags contain "};
+  static re2::LazyRE2 kContaineeMatcher = {
+      "([[:digit:]]+) (.*?) bags?(?:, |.)"};
+
+  re2::StringPiece rule_txt_sp(rule_txt.data(), rule_txt.size());
+  re2::StringPiece container_color;
+  CHECK(re2::RE2::Consume(&rule_txt_sp, *kContainerMatcher, &container_color));
+
+  BagRule rule{.container_color = ToStringView(container_color)};
+  if (rule_txt_sp == "no other bags.") return rule;
+
+  while (!rule_txt_sp.empty()) {
+    int containee_count = 0;
+    re2::StringPiece containee_color;
+    CHECK(re2::RE2::Consume(&rule_txt_sp, *kContaineeMatcher, &containee_count,
+                            &containee_color));
+    rule.contained_bags.emplace_back(ContainedBags{
+        .color = ToStringView(containee_color), .count = containee_count});
+  }
+  return rule;
+}
+
+// Parses every line with `parse`, printing how long it took.
+template <typename Parse>
+std::vector<BagRule> TimeParser(const char* name,
+                                const std::vector<std::string>& lines,
+                                Parse parse) {
+  std::vector<BagRule> rules;
+  rules.reserve(lines.size());
+  const auto start = std::chrono::steady_clock::now();
+  for (const absl::string_view line : lines) {
+    rules.push_back(parse(line));
+  }
+  const double milliseconds = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+  std::cout << name << ": " << milliseconds << " ms, "
+            << lines.size() / milliseconds / 1000 << "M rules/s\n";
+  return rules;
+}
+
+bool SameRule(const BagRule& a, const BagRule& b) {
+  if (a.container_color != b.container_color ||
+      a.contained_bags.size() != b.contained_bags.size()) {
+    return false;
+  }
+  for (std::size_t idx = 0; idx < a.contained_bags.size(); ++idx) {
+    if (a.contained_bags[idx].color != b.contained_bags[idx].color ||
+        a.contained_bags[idx].count != b.contained_bags[idx].count) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CHECK(argc <= 3);
+  int num_rules = 1000000;
+  std::uint32_t seed = 1;
+  if (argc >= 2) CHECK(absl::SimpleAtoi(argv[1], &num_rules));
+  if (argc >= 3) CHECK(absl::SimpleAtoi(argv[2], &seed));
+  CHECK(num_rules > 0);
+
+  std::mt19937 rng(seed);
+  const std::vector<std::string> lines = RandomRules(num_rules, rng);
+
+  const std::vector<BagRule> re2_rules =
+      TimeParser("re2", lines, ParseBagRuleWithRe2);
+  const std::vector<BagRule> hand_rules =
+      TimeParser("hand-written", lines, aoc2020::ParseBagRule);
+  for (std::size_t idx = 0; idx < lines.size(); ++idx) {
+    if (SameRule(re2_rules[idx], hand_rules[idx])) continue;
+    std::cout << "Parsers disagree on: " << lines[idx] << "\n";
+    return 1;
+  }
+  return 0;
+}
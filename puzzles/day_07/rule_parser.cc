@@ -1,38 +1,62 @@
 #include "puzzles/day_07/rule_parser.h"
 
+#include <cstddef>
+
 #include "absl/strings/string_view.h"
-#include "re2/re2.h"
-#include "re2/stringpiece.h"
+#include "absl/strings/strip.h"
 #include "util/check.h"
 
 namespace aoc2020 {
 namespace {
 
-absl::string_view ToStringView(re2::StringPiece sp) {
-  return absl::string_view(sp.data(), sp.size());
+constexpr absl::string_view kContainSeparator = " bags contain ";
+constexpr absl::string_view kNoOtherBags = "no other bags.";
+constexpr absl::string_view kBag = " bag";
+
+// At most this many digits are accepted in a count, so that it always fits in
+// an int.
+constexpr std::size_t kMaxCountDigits = 9;
+
+// Consumes a run of decimal digits from the front of `text` and returns their
+// value.
+int ConsumeCount(absl::string_view* text) {
+  int count = 0;
+  std::size_t idx = 0;
+  while (idx < text->size() && (*text)[idx] >= '0' && (*text)[idx] <= '9') {
+    CHECK(idx < kMaxCountDigits);
+    count = count * 10 + ((*text)[idx] - '0');
+    ++idx;
+  }
+  CHECK(idx > 0);
+  text->remove_prefix(idx);
+  return count;
 }
 
 }  // namespace
 
 BagRule ParseBagRule(absl::string_view rule_txt) {
-  static re2::LazyRE2 kContainerMatcher = {"(.*?) bags contain "};
-  static re2::LazyRE2 kContaineeMatcher = {
-      "([[:digit:]]+) (.*?) bags?(?:, |.)"};
-
-  re2::StringPiece rule_txt_sp(rule_txt);
-  re2::StringPiece container_color;
-  CHECK(re2::RE2::Consume(&rule_txt_sp, *kContainerMatcher, &container_color));
-
-  BagRule rule{.container_color = ToStringView(container_color)};
-  if (rule_txt_sp == "no other bags.") return rule;
-
-  while (!rule_txt_sp.empty()) {
-    int containee_count = 0;
-    re2::StringPiece containee_color;
-    CHECK(re2::RE2::Consume(&rule_txt_sp, *kContaineeMatcher, &containee_count,
-                            &containee_color));
+  const std::size_t container_end = rule_txt.find(kContainSeparator);
+  CHECK(container_end != absl::string_view::npos);
+
+  BagRule rule{.container_color = rule_txt.substr(0, container_end)};
+  rule_txt.remove_prefix(container_end + kContainSeparator.size());
+  if (rule_txt == kNoOtherBags) return rule;
+
+  while (!rule_txt.empty()) {
+    const int containee_count = ConsumeCount(&rule_txt);
+    CHECK(absl::ConsumePrefix(&rule_txt, " "));
+
+    const std::size_t color_end = rule_txt.find(kBag);
+    CHECK(color_end != absl::string_view::npos);
     rule.contained_bags.emplace_back(ContainedBags{
-        .color = ToStringView(containee_color), .count = containee_count});
+        .color = rule_txt.substr(0, color_end), .count = containee_count});
+    rule_txt.remove_prefix(color_end + kBag.size());
+
+    absl::ConsumePrefix(&rule_txt, "s");
+    if (!absl::ConsumePrefix(&rule_txt, ", ")) {
+      CHECK(rule_txt == ".");
+      rule_txt.remove_prefix(1);
+    }
   }
   return rule;
 }
@@ -0,0 +1,188 @@
+#include "puzzles/day_08/handheld_jit.h"
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#define HAVE_HANDHELD_JIT 1
+#else
+#define HAVE_HANDHELD_JIT 0
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "puzzles/day_08/handheld_vm.h"
+#include "util/check.h"
+
+namespace aoc2020::handheld {
+namespace {
+
+#if HAVE_HANDHELD_JIT
+
+// Emits x86-64 machine code for a handheld program. The generated function
+// follows the System V calling convention with arguments
+// (int* accumulator, uint32_t* visited_epoch, uint32_t epoch), keeps the
+// accumulator in eax and the epoch in ecx, and returns whether the program
+// terminated.
+class Assembler {
+ public:
+  // Upper bounds on the size of the generated code: every instruction's block
+  // is at most kMaxBlockBytes, plus kFixedBytes for the prologue and
+  // epilogue. Keeping the total within int32 keeps every rel32 jump and
+  // marker displacement in range.
+  static inline constexpr std::size_t kMaxBlockBytes = 23;
+  static inline constexpr std::size_t kFixedBytes = 32;
+  static inline constexpr std::size_t kMaxInstructions =
+      (std::numeric_limits<std::int32_t>::max() - kFixedBytes) /
+      kMaxBlockBytes;
+
+  explicit Assembler(absl::Span<const Instruction> program)
+      : program_(program), block_offsets_(program.size() + 1, 0) {}
+
+  std::vector<std::uint8_t> Assemble() {
+    // Prologue.
+    Emit({0x31, 0xC0});  // xor eax, eax
+    Emit({0x89, 0xD1});  // mov ecx, edx
+
+    for (std::size_t pc = 0; pc < program_.size(); ++pc) {
+      block_offsets_[pc] = code_.size();
+      const std::int32_t marker_offset = static_cast<std::int32_t>(pc * 4);
+      Emit({0x39, 0x8E});  // cmp [rsi + marker_offset], ecx
+      EmitInt32(marker_offset);
+      Emit({0x0F, 0x84});  // je not_terminated
+      not_terminated_fixups_.push_back(code_.size());
+      EmitInt32(0);
+      Emit({0x89, 0x8E});  // mov [rsi + marker_offset], ecx
+      EmitInt32(marker_offset);
+
+      const Instruction& instruction = program_[pc];
+      switch (instruction.opcode) {
+        case Opcode::kAcc:
+          Emit({0x05});  // add eax, imm32
+          EmitInt32(instruction.argument);
+          break;
+        case Opcode::kJmp: {
+          const std::int64_t target =
+              static_cast<std::int64_t>(pc) + instruction.argument;
+          Emit({0xE9});  // jmp rel32
+          const std::int64_t end = static_cast<std::int64_t>(program_.size());
+          if (target < 0 || target > end) {
+            not_terminated_fixups_.push_back(code_.size());
+          } else {
+            block_fixups_.push_back(
+                {code_.size(), static_cast<std::size_t>(target)});
+          }
+          EmitInt32(0);
+          break;
+        }
+        case Opcode::kNop:
+          break;
+      }
+    }
+
+    // Falling off the end of the last block (or jumping just past it) means
+    // the program terminated.
+    block_offsets_[program_.size()] = code_.size();
+    Emit({0xBA});  // mov edx, 1
+    EmitInt32(1);
+    Emit({0xEB, 0x05});  // jmp epilogue (over the next instruction)
+
+    const std::size_t not_terminated = code_.size();
+    Emit({0xBA});  // mov edx, 0
+    EmitInt32(0);
+
+    // Epilogue.
+    Emit({0x89, 0x07});  // mov [rdi], eax
+    Emit({0x89, 0xD0});  // mov eax, edx
+    Emit({0xC3});        // ret
+    CHECK(code_.size() <= program_.size() * kMaxBlockBytes + kFixedBytes);
+
+    for (const std::size_t fixup : not_terminated_fixups_) {
+      PatchRel32(fixup, not_terminated);
+    }
+    for (const BlockFixup& fixup : block_fixups_) {
+      PatchRel32(fixup.position, block_offsets_[fixup.block]);
+    }
+    return std::move(code_);
+  }
+
+ private:
+  struct BlockFixup {
+    std::size_t position = 0;
+    std::size_t block = 0;
+  };
+
+  void Emit(std::initializer_list<std::uint8_t> bytes) {
+    code_.insert(code_.end(), bytes.begin(), bytes.end());
+  }
+
+  void EmitInt32(const std::int32_t value) {
+    std::uint8_t bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    code_.insert(code_.end(), bytes, bytes + sizeof(bytes));
+  }
+
+  // Points the rel32 operand at `position` to `target`. The displacement is
+  // relative to the end of the operand.
+  void PatchRel32(const std::size_t position, const std::size_t target) {
+    const std::int64_t rel = static_cast<std::int64_t>(target) -
+                             static_cast<std::int64_t>(position + 4);
+    CHECK(rel >= std::numeric_limits<std::int32_t>::min() &&
+          rel <= std::numeric_limits<std::int32_t>::max());
+    const std::int32_t rel32 = static_cast<std::int32_t>(rel);
+    std::memcpy(&code_[position], &rel32, sizeof(rel32));
+  }
+
+  absl::Span<const Instruction> program_;
+  std::vector<std::uint8_t> code_;
+  std::vector<std::size_t> block_offsets_;
+  std::vector<std::size_t> not_terminated_fixups_;
+  std::vector<BlockFixup> block_fixups_;
+};
+
+#endif  // HAVE_HANDHELD_JIT
+
+}  // namespace
+
+CompiledProgram::CompiledProgram(absl::Span<const Instruction> program)
+    : program_(program.begin(), program.end()) {
+#if HAVE_HANDHELD_JIT
+  if (program_.size() > Assembler::kMaxInstructions) return;
+
+  const std::vector<std::uint8_t> code = Assembler(program_).Assemble();
+  void* mapped = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) return;
+  std::memcpy(mapped, code.data(), code.size());
+  if (mprotect(mapped, code.size(), PROT_READ | PROT_EXEC) != 0) {
+    munmap(mapped, code.size());
+    return;
+  }
+  code_ = mapped;
+  code_size_ = code.size();
+#endif  // HAVE_HANDHELD_JIT
+}
+
+CompiledProgram::~CompiledProgram() {
+#if HAVE_HANDHELD_JIT
+  if (code_ != nullptr) munmap(code_, code_size_);
+#endif  // HAVE_HANDHELD_JIT
+}
+
+RunResult CompiledProgram::Run() {
+  if (code_ == nullptr) return vm_.Run(program_);
+
+  const std::uint32_t epoch = visited_.NextEpoch(program_.size());
+  const NativeFn native = reinterpret_cast<NativeFn>(code_);
+  RunResult result;
+  result.terminated =
+      native(&result.accumulator, visited_.data(), epoch) != 0;
+  return result;
+}
+
+}  // namespace aoc2020::handheld
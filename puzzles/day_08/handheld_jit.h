@@ -0,0 +1,50 @@
+#ifndef PUZZLES_DAY_08_HANDHELD_JIT_H_
+#define PUZZLES_DAY_08_HANDHELD_JIT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "puzzles/day_08/handheld_vm.h"
+#include "util/epoch_marks.h"
+
+namespace aoc2020::handheld {
+
+// A handheld program translated to native x86-64 code, for programs that are
+// run many times. Each instruction becomes a short block that checks and sets
+// its own visited marker before doing its work, so loop detection costs a
+// compare and a store per instruction. On hosts other than x86-64 Linux (or if
+// executable memory can't be mapped) this falls back to HandheldVm, with the
+// same results.
+class CompiledProgram {
+ public:
+  explicit CompiledProgram(absl::Span<const Instruction> program);
+  ~CompiledProgram();
+
+  CompiledProgram(const CompiledProgram&) = delete;
+  CompiledProgram& operator=(const CompiledProgram&) = delete;
+
+  // Whether native code was generated. If not, Run() uses the interpreter.
+  bool jitted() const { return code_ != nullptr; }
+
+  // Same contract as HandheldVm::Run().
+  RunResult Run();
+
+ private:
+  // Signature of the generated code. Returns 1 if the program terminated and
+  // 0 otherwise, storing the final accumulator in `*accumulator`.
+  using NativeFn = int (*)(int* accumulator, std::uint32_t* visited_epoch,
+                           std::uint32_t epoch);
+
+  std::vector<Instruction> program_;
+  HandheldVm vm_;
+
+  void* code_ = nullptr;
+  std::size_t code_size_ = 0;
+  EpochMarks visited_;
+};
+
+}  // namespace aoc2020::handheld
+
+#endif  // PUZZLES_DAY_08_HANDHELD_JIT_H_
@@ -0,0 +1,67 @@
+#include "puzzles/day_08/handheld_trace.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+namespace aoc2020::handheld {
+namespace {
+
+std::size_t RoundUpToPowerOfTwo(const std::size_t value) {
+  std::size_t rounded = 1;
+  while (rounded < value) rounded <<= 1;
+  return rounded;
+}
+
+}  // namespace
+
+ExecutionTrace::ExecutionTrace(const std::size_t recent_capacity)
+    : recent_(RoundUpToPowerOfTwo(recent_capacity), 0),
+      recent_mask_(recent_.size() - 1) {}
+
+void ExecutionTrace::OnStart(const std::size_t program_size) {
+  if (hit_counts_.size() < program_size) hit_counts_.resize(program_size, 0);
+}
+
+void ExecutionTrace::Clear() {
+  std::fill(hit_counts_.begin(), hit_counts_.end(), 0);
+  recent_end_ = 0;
+  loop_entry_ = absl::nullopt;
+}
+
+std::vector<std::uint32_t> ExecutionTrace::Recent() const {
+  const std::uint64_t recent_begin =
+      recent_end_ > recent_.size() ? recent_end_ - recent_.size() : 0;
+  std::vector<std::uint32_t> recent;
+  recent.reserve(recent_end_ - recent_begin);
+  for (std::uint64_t idx = recent_begin; idx < recent_end_; ++idx) {
+    recent.push_back(recent_[idx & recent_mask_]);
+  }
+  return recent;
+}
+
+std::string ExecutionTrace::Dump() const {
+  std::string dump;
+  if (loop_entry_.has_value()) {
+    absl::StrAppend(&dump, "loop_entry ", *loop_entry_, "\n");
+  } else {
+    absl::StrAppend(&dump, "loop_entry none\n");
+  }
+  for (std::size_t pc = 0; pc < hit_counts_.size(); ++pc) {
+    if (hit_counts_[pc] == 0) continue;
+    absl::StrAppend(&dump, "hits ", pc, " ", hit_counts_[pc], "\n");
+  }
+  absl::StrAppend(&dump, "recent");
+  for (const std::uint32_t pc : Recent()) {
+    absl::StrAppend(&dump, " ", pc);
+  }
+  absl::StrAppend(&dump, "\n");
+  return dump;
+}
+
+}  // namespace aoc2020::handheld
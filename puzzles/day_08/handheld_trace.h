@@ -0,0 +1,79 @@
+#ifndef PUZZLES_DAY_08_HANDHELD_TRACE_H_
+#define PUZZLES_DAY_08_HANDHELD_TRACE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+
+namespace aoc2020::handheld {
+
+// Tracing policies for HandheldVm. The interpreter is instantiated once per
+// policy and calls the hooks below inline, so tracing has no cost at all when
+// the policy is NoTrace.
+//
+// A policy provides:
+//   void OnStart(std::size_t program_size);  // Before the first instruction.
+//   void OnInstruction(std::size_t pc);      // Before each instruction runs.
+//   void OnLoop(std::size_t pc);  // When `pc` is about to run a second time.
+struct NoTrace {
+  void OnStart(std::size_t) {}
+  void OnInstruction(std::size_t) {}
+  void OnLoop(std::size_t) {}
+};
+
+// Records how many times each instruction ran, the most recently executed
+// instructions, and where the program looped. Counts accumulate across runs
+// until Clear() is called, which makes it easy to see where a series of runs
+// (e.g. trying each repair in turn) spent its time.
+class ExecutionTrace {
+ public:
+  // Remembers the last `recent_capacity` instructions executed, which is
+  // rounded up to a power of two.
+  explicit ExecutionTrace(std::size_t recent_capacity = 64);
+
+  void OnStart(std::size_t program_size);
+
+  void OnInstruction(const std::size_t pc) {
+    ++hit_counts_[pc];
+    recent_[recent_end_++ & recent_mask_] = static_cast<std::uint32_t>(pc);
+  }
+
+  void OnLoop(const std::size_t pc) { loop_entry_ = pc; }
+
+  void Clear();
+
+  const std::vector<std::uint64_t>& hit_counts() const { return hit_counts_; }
+
+  // The instruction that was about to run a second time in the most recent
+  // run that looped, if any.
+  absl::optional<std::size_t> loop_entry() const { return loop_entry_; }
+
+  // The most recently executed instructions, oldest first.
+  std::vector<std::uint32_t> Recent() const;
+
+  // Renders the trace as plain text with one fact per line, so that dumps from
+  // different runs can be compared with `diff`:
+  //
+  //   loop_entry 7
+  //   hits 0 1
+  //   hits 1 1
+  //   ...
+  //   recent 0 1 2 7 3 4 6 7
+  //
+  // Instructions that never ran are omitted from the `hits` lines.
+  std::string Dump() const;
+
+ private:
+  std::vector<std::uint64_t> hit_counts_;
+  std::vector<std::uint32_t> recent_;
+  std::size_t recent_mask_ = 0;
+  std::uint64_t recent_end_ = 0;
+  absl::optional<std::size_t> loop_entry_;
+};
+
+}  // namespace aoc2020::handheld
+
+#endif  // PUZZLES_DAY_08_HANDHELD_TRACE_H_
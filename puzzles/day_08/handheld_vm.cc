@@ -0,0 +1,196 @@
+#include "puzzles/day_08/handheld_vm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+#include "puzzles/day_08/handheld_trace.h"
+#include "util/check.h"
+
+namespace aoc2020::handheld {
+namespace {
+
+// Returns the index of the instruction that runs after `program[pc]` if its
+// opcode were `opcode`. Out-of-bounds results wrap to huge values, as in
+// HandheldVm::Run().
+std::size_t Successor(const Opcode opcode,
+                      absl::Span<const Instruction> program,
+                      const std::size_t pc) {
+  return opcode == Opcode::kJmp ? pc + program[pc].argument : pc + 1;
+}
+
+Opcode Flipped(const Opcode opcode) {
+  switch (opcode) {
+    case Opcode::kAcc:
+      return Opcode::kAcc;
+    case Opcode::kJmp:
+      return Opcode::kNop;
+    case Opcode::kNop:
+      return Opcode::kJmp;
+  }
+  CHECK_FAIL();
+}
+
+// Returns, for every instruction index in [0, program.size()], whether
+// running from that index reaches the end of the program. The extra final
+// entry is the end itself.
+std::vector<bool> FindTerminatingInstructions(
+    absl::Span<const Instruction> program) {
+  const std::size_t size = program.size();
+
+  // Predecessors of each index in [0, size], in compressed sparse row form.
+  std::vector<std::size_t> offsets(size + 2, 0);
+  for (std::size_t pc = 0; pc < size; ++pc) {
+    const std::size_t next = Successor(program[pc].opcode, program, pc);
+    if (next <= size) ++offsets[next + 1];
+  }
+  for (std::size_t idx = 0; idx <= size; ++idx) {
+    offsets[idx + 1] += offsets[idx];
+  }
+  std::vector<std::size_t> predecessors(offsets.back());
+  std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+  for (std::size_t pc = 0; pc < size; ++pc) {
+    const std::size_t next = Successor(program[pc].opcode, program, pc);
+    if (next <= size) predecessors[fill[next]++] = pc;
+  }
+
+  std::vector<bool> terminating(size + 1, false);
+  terminating[size] = true;
+  std::vector<std::size_t> unprocessed = {size};
+  while (!unprocessed.empty()) {
+    const std::size_t current = unprocessed.back();
+    unprocessed.pop_back();
+    for (std::size_t edge = offsets[current]; edge < offsets[current + 1];
+         ++edge) {
+      const std::size_t pred = predecessors[edge];
+      if (terminating[pred]) continue;
+      terminating[pred] = true;
+      unprocessed.push_back(pred);
+    }
+  }
+  return terminating;
+}
+
+}  // namespace
+
+Instruction ParseInstruction(absl::string_view instruction_str) {
+  Instruction parsed;
+  char opcode_str[4];
+  CHECK(2 == std::sscanf(instruction_str.data(), "%3s %d", opcode_str,
+                         &parsed.argument));
+  if (std::strcmp(opcode_str, "acc") == 0) {
+    parsed.opcode = Opcode::kAcc;
+  } else if (std::strcmp(opcode_str, "jmp") == 0) {
+    parsed.opcode = Opcode::kJmp;
+  } else if (std::strcmp(opcode_str, "nop") == 0) {
+    parsed.opcode = Opcode::kNop;
+  } else {
+    CHECK_FAIL();
+  }
+  return parsed;
+}
+
+std::vector<Instruction> ParseProgram(const std::vector<std::string>& lines) {
+  std::vector<Instruction> program;
+  program.reserve(lines.size());
+  for (const absl::string_view line : lines) {
+    program.push_back(ParseInstruction(line));
+  }
+  return program;
+}
+
+RunResult HandheldVm::Run(absl::Span<const Instruction> program) {
+  NoTrace trace;
+  return RunWithTrace(program, trace);
+}
+
+RunResult HandheldVm::Run(absl::Span<const Instruction> program,
+                          ExecutionTrace* trace) {
+  return RunWithTrace(program, *trace);
+}
+
+template <typename TracePolicy>
+RunResult HandheldVm::RunWithTrace(absl::Span<const Instruction> program,
+                                   TracePolicy& trace) {
+  // Indexed by Opcode.
+  static void* const kHandlers[] = {&&acc, &&jmp, &&nop};
+
+  trace.OnStart(program.size());
+  const std::uint32_t epoch = visited_.NextEpoch(program.size());
+  std::uint32_t* const visited = visited_.data();
+  const Instruction* const code = program.data();
+  const std::size_t size = program.size();
+
+  int accumulator = 0;
+  std::size_t pc = 0;
+
+#define DISPATCH()                                                  \
+  do {                                                              \
+    if (pc >= size) {                                               \
+      return RunResult{.terminated = (pc == size),                  \
+                       .accumulator = accumulator};                 \
+    }                                                               \
+    if (visited[pc] == epoch) {                                     \
+      trace.OnLoop(pc);                                             \
+      return RunResult{.terminated = false,                         \
+                       .accumulator = accumulator};                 \
+    }                                                               \
+    visited[pc] = epoch;                                            \
+    trace.OnInstruction(pc);                                        \
+    goto* kHandlers[static_cast<int>(code[pc].opcode)];             \
+  } while (false)
+
+  DISPATCH();
+
+acc:
+  accumulator += code[pc].argument;
+  ++pc;
+  DISPATCH();
+
+jmp:
+  // Negative jumps wrap around to huge values and are caught as out of bounds.
+  pc += code[pc].argument;
+  DISPATCH();
+
+nop:
+  ++pc;
+  DISPATCH();
+
+#undef DISPATCH
+}
+
+absl::optional<int> RunRepaired(absl::Span<const Instruction> program) {
+  const std::size_t size = program.size();
+  const std::vector<bool> terminating = FindTerminatingInstructions(program);
+  if (terminating[0]) return absl::nullopt;
+
+  // Walk the original (looping) execution path. Every instruction on it leads
+  // back into the loop, so the repair is the first jmp or nop on it whose
+  // flipped successor would instead lead to the end.
+  std::vector<bool> visited(size, false);
+  std::size_t pc = 0;
+  while (pc < size && !visited[pc]) {
+    visited[pc] = true;
+    const Opcode opcode = program[pc].opcode;
+    if (opcode != Opcode::kAcc) {
+      const std::size_t flipped_next = Successor(Flipped(opcode), program, pc);
+      if (flipped_next <= size && terminating[flipped_next]) {
+        std::vector<Instruction> repaired(program.begin(), program.end());
+        repaired[pc].opcode = Flipped(opcode);
+        const RunResult result = HandheldVm().Run(repaired);
+        CHECK(result.terminated);
+        return result.accumulator;
+      }
+    }
+    pc = Successor(opcode, program, pc);
+  }
+  return absl::nullopt;
+}
+
+}  // namespace aoc2020::handheld
@@ -0,0 +1,73 @@
+#ifndef PUZZLES_DAY_08_HANDHELD_VM_H_
+#define PUZZLES_DAY_08_HANDHELD_VM_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+#include "puzzles/day_08/handheld_trace.h"
+#include "util/epoch_marks.h"
+
+namespace aoc2020::handheld {
+
+enum class Opcode {
+  kAcc,
+  kJmp,
+  kNop,
+};
+
+struct Instruction {
+  Opcode opcode = Opcode::kNop;
+  int argument = 0;
+};
+
+Instruction ParseInstruction(absl::string_view instruction_str);
+
+std::vector<Instruction> ParseProgram(const std::vector<std::string>& lines);
+
+struct RunResult {
+  // True if the program ran off the end by trying to execute the instruction
+  // just past the last one. False if it was stopped because an instruction
+  // was about to run a second time, or because it jumped out of bounds.
+  bool terminated = false;
+  int accumulator = 0;
+};
+
+// Interpreter for handheld programs. Dispatch is threaded through a table of
+// computed-goto labels rather than a switch, and visited instructions are
+// tracked in a dense array of epochs so that repeated runs (of the same or
+// different programs) don't need to clear any state between them.
+class HandheldVm {
+ public:
+  // Runs `program` from the first instruction until it terminates or is about
+  // to execute some instruction a second time.
+  RunResult Run(absl::Span<const Instruction> program);
+
+  // As above, but also records the run into `trace`.
+  RunResult Run(absl::Span<const Instruction> program, ExecutionTrace* trace);
+
+ private:
+  template <typename TracePolicy>
+  RunResult RunWithTrace(absl::Span<const Instruction> program,
+                         TracePolicy& trace);
+
+  EpochMarks visited_;
+};
+
+// Repairs a program that loops forever by flipping a single `jmp` to a `nop`
+// (or vice versa), and returns the accumulator when the repaired program
+// terminates. Returns nullopt if `program` already terminates or if no single
+// flip makes it terminate.
+//
+// Rather than retrying the program once per candidate flip, this finds every
+// instruction that leads to termination by walking the control-flow graph
+// backwards from the end, then walks the original execution path once looking
+// for an instruction whose flipped successor is in that set. O(n) overall.
+absl::optional<int> RunRepaired(absl::Span<const Instruction> program);
+
+}  // namespace aoc2020::handheld
+
+#endif  // PUZZLES_DAY_08_HANDHELD_VM_H_
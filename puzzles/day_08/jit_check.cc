@@ -0,0 +1,101 @@
+// Cross-checks CompiledProgram against HandheldVm on randomly generated
+// programs. Usage: jit_check [num_programs [seed]]. Prints the first
+// mismatching program and exits nonzero if the two ever disagree.
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "puzzles/day_08/handheld_jit.h"
+#include "puzzles/day_08/handheld_vm.h"
+#include "util/check.h"
+
+namespace {
+
+using aoc2020::handheld::CompiledProgram;
+using aoc2020::handheld::HandheldVm;
+using aoc2020::handheld::Instruction;
+using aoc2020::handheld::Opcode;
+using aoc2020::handheld::RunResult;
+
+// Generates a program of up to 200 instructions. Half of the jumps are short
+// forward jumps, so that a good share of programs terminate instead of
+// looping; the rest may jump backwards or out of bounds in either direction.
+std::vector<Instruction> RandomProgram(std::mt19937& rng) {
+  std::vector<Instruction> program(rng() % 200);
+  for (Instruction& instruction : program) {
+    switch (rng() % 3) {
+      case 0:
+        instruction.opcode = Opcode::kAcc;
+        break;
+      case 1:
+        instruction.opcode = Opcode::kJmp;
+        break;
+      default:
+        instruction.opcode = Opcode::kNop;
+        break;
+    }
+    instruction.argument = static_cast<int>(rng() % 41) - 20;
+    if (instruction.opcode == Opcode::kJmp && rng() % 2 == 0) {
+      instruction.argument = 1 + rng() % 4;
+    }
+  }
+  return program;
+}
+
+const char* OpcodeName(const Opcode opcode) {
+  switch (opcode) {
+    case Opcode::kAcc:
+      return "acc";
+    case Opcode::kJmp:
+      return "jmp";
+    case Opcode::kNop:
+      return "nop";
+  }
+  CHECK_FAIL();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CHECK(argc <= 3);
+  int num_programs = 20000;
+  std::uint32_t seed = 1;
+  if (argc >= 2) CHECK(absl::SimpleAtoi(argv[1], &num_programs));
+  if (argc >= 3) CHECK(absl::SimpleAtoi(argv[2], &seed));
+
+  std::mt19937 rng(seed);
+  HandheldVm vm;
+  int jitted = 0;
+  for (int idx = 0; idx < num_programs; ++idx) {
+    const std::vector<Instruction> program = RandomProgram(rng);
+    CompiledProgram compiled(program);
+    jitted += compiled.jitted();
+    // Run more than once to exercise the visited-marker epochs.
+    for (int run = 0; run < 3; ++run) {
+      const RunResult expected = vm.Run(program);
+      const RunResult actual = compiled.Run();
+      if (expected.terminated == actual.terminated &&
+          expected.accumulator == actual.accumulator) {
+        continue;
+      }
+      std::cout << "Mismatch on program " << idx << ", run " << run
+                << ": interpreter terminated=" << expected.terminated
+                << " accumulator=" << expected.accumulator
+                << ", jit terminated=" << actual.terminated
+                << " accumulator=" << actual.accumulator << "\n";
+      for (const Instruction& instruction : program) {
+        std::cout << OpcodeName(instruction.opcode) << " "
+                  << (instruction.argument >= 0 ? "+" : "")
+                  << instruction.argument << "\n";
+      }
+      return 1;
+    }
+  }
+
+  std::cout << num_programs << " programs matched (" << jitted
+            << " jitted)\n";
+  return 0;
+}
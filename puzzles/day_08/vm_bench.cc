@@ -0,0 +1,132 @@
+// Measures instructions per second for HandheldVm, CompiledProgram, and the
+// switch-and-hash-set interpreter HandheldVm replaced, on a long generated
+// program. Usage: vm_bench [num_instructions [seed]].
+//
+// The program is a random mix of `acc`, `nop` and `jmp +1`, so every
+// instruction runs exactly once before the program terminates, and the
+// opcode sequence gives the dispatch branch nothing to predict.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/numbers.h"
+#include "absl/types/span.h"
+#include "puzzles/day_08/handheld_jit.h"
+#include "puzzles/day_08/handheld_vm.h"
+#include "util/check.h"
+
+namespace {
+
+using aoc2020::handheld::CompiledProgram;
+using aoc2020::handheld::HandheldVm;
+using aoc2020::handheld::Instruction;
+using aoc2020::handheld::Opcode;
+using aoc2020::handheld::RunResult;
+
+constexpr int kRepetitions = 3;
+
+std::vector<Instruction> StraightLineProgram(const int size,
+                                             std::mt19937& rng) {
+  std::vector<Instruction> program(size);
+  for (Instruction& instruction : program) {
+    switch (rng() % 3) {
+      case 0:
+        instruction = Instruction{.opcode = Opcode::kAcc,
+                                  .argument = static_cast<int>(rng() % 3) - 1};
+        break;
+      case 1:
+        instruction = Instruction{.opcode = Opcode::kJmp, .argument = 1};
+        break;
+      default:
+        instruction = Instruction{.opcode = Opcode::kNop,
+                                  .argument = static_cast<int>(rng() % 9) - 4};
+        break;
+    }
+  }
+  return program;
+}
+
+// The baseline interpreter, extended to stop at the end of the program.
+RunResult RunWithSwitch(absl::Span<const Instruction> program) {
+  int accumulator = 0;
+  absl::flat_hash_set<std::size_t> visited_instructions;
+  std::size_t current_instruction = 0;
+  while (current_instruction < program.size()) {
+    if (!visited_instructions.insert(current_instruction).second) {
+      return RunResult{.terminated = false, .accumulator = accumulator};
+    }
+
+    const Instruction current = program[current_instruction];
+    switch (current.opcode) {
+      case Opcode::kAcc:
+        accumulator += current.argument;
+        ++current_instruction;
+        break;
+      case Opcode::kJmp:
+        current_instruction += current.argument;
+        break;
+      case Opcode::kNop:
+        ++current_instruction;
+        break;
+    }
+  }
+  return RunResult{.terminated = current_instruction == program.size(),
+                   .accumulator = accumulator};
+}
+
+// Runs `run` kRepetitions times and prints the best rate. Every run must
+// terminate with `expected_accumulator`.
+template <typename Run>
+void Measure(const char* name, const std::size_t num_instructions,
+             const int expected_accumulator, Run run) {
+  double best_seconds = 0;
+  for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+    const auto start = std::chrono::steady_clock::now();
+    const RunResult result = run();
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    CHECK(result.terminated);
+    CHECK(result.accumulator == expected_accumulator);
+    if (repetition == 0 || seconds < best_seconds) best_seconds = seconds;
+  }
+  std::cout << name << ": " << num_instructions / best_seconds / 1e6
+            << "M instructions/s\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CHECK(argc <= 3);
+  int num_instructions = 10000000;
+  std::uint32_t seed = 1;
+  if (argc >= 2) CHECK(absl::SimpleAtoi(argv[1], &num_instructions));
+  if (argc >= 3) CHECK(absl::SimpleAtoi(argv[2], &seed));
+  CHECK(num_instructions > 0);
+
+  std::mt19937 rng(seed);
+  const std::vector<Instruction> program =
+      StraightLineProgram(num_instructions, rng);
+  int expected_accumulator = 0;
+  for (const Instruction& instruction : program) {
+    if (instruction.opcode == Opcode::kAcc) {
+      expected_accumulator += instruction.argument;
+    }
+  }
+
+  Measure("switch + flat_hash_set", program.size(), expected_accumulator,
+          [&] { return RunWithSwitch(program); });
+  HandheldVm vm;
+  Measure("HandheldVm", program.size(), expected_accumulator,
+          [&] { return vm.Run(program); });
+  CompiledProgram compiled(program);
+  Measure(compiled.jitted() ? "CompiledProgram" : "CompiledProgram (no jit)",
+          program.size(), expected_accumulator,
+          [&] { return compiled.Run(); });
+  return 0;
+}
@@ -1,7 +1,6 @@
 #include <cstdint>
 #include <iostream>
 #include <string>
-#include <vector>
 
 #include "absl/strings/numbers.h"
 #include "puzzles/day_09/xmas_cipher.h"
@@ -11,15 +10,20 @@
 int main(int argc, char** argv) {
   CHECK(3 == argc);
 
-  std::vector<std::string> lines = aoc2020::ReadLinesFromFile(argv[1]);
-  std::vector<std::int64_t> numbers =
-      aoc2020::ParseIntegers<std::int64_t>(lines);
-
   int window_size = 0;
   CHECK(absl::SimpleAtoi(argv[2], &window_size));
 
-  std::cout << aoc2020::xmas_cipher::FindInvalidNumber(numbers, window_size)
-            << "\n";
+  aoc2020::xmas_cipher::XmasStream stream(window_size);
+  aoc2020::LineReader reader(argv[1]);
+  std::string line;
+  while (reader.Next(&line)) {
+    std::int64_t number = 0;
+    CHECK(absl::SimpleAtoi(line, &number));
+    if (stream.Push(number)) {
+      std::cout << number << "\n";
+      return 0;
+    }
+  }
 
-  return 0;
+  CHECK_FAIL();
 }
@@ -1,24 +1,43 @@
 #include <cstdint>
 #include <iostream>
 #include <string>
-#include <vector>
 
 #include "absl/strings/numbers.h"
 #include "puzzles/day_09/xmas_cipher.h"
 #include "util/check.h"
 #include "util/io.h"
 
+namespace {
+
+// Streams the numbers in `filename` into `stream` until it accepts one, and
+// returns that number.
+template <typename Stream>
+std::int64_t PushUntilFound(const char* filename, Stream& stream) {
+  aoc2020::LineReader reader(filename);
+  std::string line;
+  while (reader.Next(&line)) {
+    std::int64_t number = 0;
+    CHECK(absl::SimpleAtoi(line, &number));
+    if (stream.Push(number)) return number;
+  }
+  CHECK_FAIL();
+}
+
+}  // namespace
+
 int main(int argc, char** argv) {
   CHECK(3 == argc);
 
-  std::vector<std::string> lines = aoc2020::ReadLinesFromFile(argv[1]);
-  std::vector<std::int64_t> numbers =
-      aoc2020::ParseIntegers<std::int64_t>(lines);
-
   int window_size = 0;
   CHECK(absl::SimpleAtoi(argv[2], &window_size));
 
-  std::cout << aoc2020::xmas_cipher::CrackCode(numbers, window_size) << "\n";
+  // Two passes over the file, so that neither has to hold more than a window
+  // or a candidate range of numbers.
+  aoc2020::xmas_cipher::XmasStream xmas_stream(window_size);
+  const std::int64_t invalid = PushUntilFound(argv[1], xmas_stream);
+  aoc2020::xmas_cipher::WeaknessStream weakness_stream(invalid);
+  PushUntilFound(argv[1], weakness_stream);
+  std::cout << weakness_stream.weakness() << "\n";
 
   return 0;
 }
@@ -0,0 +1,42 @@
+#include "puzzles/day_09/range_sum.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace aoc2020::xmas_cipher {
+namespace {
+
+// Prefix sums are kept as unsigned so that intermediate overflow wraps instead
+// of being undefined. The difference of two prefixes is still exact whenever
+// the range sum itself fits in an int64_t.
+using Prefix = std::uint64_t;
+
+}  // namespace
+
+absl::optional<Range> FindRangeWithSum(absl::Span<const std::int64_t> sequence,
+                                       const std::int64_t target) {
+  // Maps each prefix sum to the first position at which it occurs. A range
+  // [begin, end) sums to `target` iff prefix(end) - prefix(begin) == target,
+  // so looking up prefix(end) - target finds the longest range ending at
+  // `end`. Prefixes are added two positions late so that every range found
+  // holds at least two numbers.
+  absl::flat_hash_map<Prefix, std::size_t> first_position;
+  Prefix lagging_prefixes[2] = {0, 0};
+  Prefix prefix = 0;
+  for (std::size_t end = 1; end <= sequence.size(); ++end) {
+    prefix += sequence[end - 1];
+    if (end >= 2) {
+      first_position.try_emplace(lagging_prefixes[end % 2], end - 2);
+      auto iter = first_position.find(prefix - target);
+      if (iter != first_position.end()) return Range{iter->second, end};
+    }
+    lagging_prefixes[end % 2] = prefix;
+  }
+  return absl::nullopt;
+}
+
+}  // namespace aoc2020::xmas_cipher
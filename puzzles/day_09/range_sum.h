@@ -0,0 +1,27 @@
+#ifndef PUZZLES_DAY_09_RANGE_SUM_H_
+#define PUZZLES_DAY_09_RANGE_SUM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace aoc2020::xmas_cipher {
+
+// The half-open range of positions [begin, end) in a sequence.
+struct Range {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+};
+
+// Returns a range of at least two contiguous numbers in `sequence` that sums
+// to `target`, or nullopt if there is none. Unlike FindWeakness(), the numbers
+// may be negative. If several ranges qualify, the one that ends first is
+// returned, and of those the longest.
+absl::optional<Range> FindRangeWithSum(absl::Span<const std::int64_t> sequence,
+                                       std::int64_t target);
+
+}  // namespace aoc2020::xmas_cipher
+
+#endif  // PUZZLES_DAY_09_RANGE_SUM_H_
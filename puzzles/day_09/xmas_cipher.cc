@@ -1,67 +1,226 @@
 #include "puzzles/day_09/xmas_cipher.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <memory>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/span.h"
 #include "util/check.h"
 
 namespace aoc2020::xmas_cipher {
 namespace {
 
-bool NextValid(const std::deque<std::int64_t>& window,
-               const std::int64_t next) {
-  for (auto outer = window.begin(); outer != window.end(); ++outer) {
-    for (auto inner = window.begin(); inner != window.end(); ++inner) {
-      if (outer == inner) continue;
-      if ((*outer + *inner) == next) return true;
-    }
+// Windows up to this size are searched by brute force, which beats a hash
+// lookup per element until the quadratic term takes over. The crossover points
+// were measured with windows that never contain a matching pair.
+#if defined(__AVX2__)
+constexpr int kMaxBruteForceWindow = 128;
+#else
+constexpr int kMaxBruteForceWindow = 32;
+#endif
+
+// Returns whether `needle` appears anywhere in `values`.
+bool Contains(const std::int64_t* values, std::size_t size,
+              const std::int64_t needle) {
+  std::size_t idx = 0;
+#if defined(__AVX2__)
+  const __m256i needle_vec = _mm256_set1_epi64x(needle);
+  __m256i found = _mm256_setzero_si256();
+  for (; idx + 4 <= size; idx += 4) {
+    const __m256i lanes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + idx));
+    found = _mm256_or_si256(found, _mm256_cmpeq_epi64(lanes, needle_vec));
+  }
+  if (!_mm256_testz_si256(found, found)) return true;
+#endif  // __AVX2__
+  for (; idx < size; ++idx) {
+    if (values[idx] == needle) return true;
   }
   return false;
 }
 
+// The last `window_size` numbers of the sequence in a contiguous ring buffer.
+// A pair sum is found by checking, for each element, whether its complement
+// appears later in the buffer. Since only the set of positions matters, the
+// ring's rotation is irrelevant.
+class BruteForceWindow {
+ public:
+  explicit BruteForceWindow(absl::Span<const std::int64_t> initial)
+      : ring_(initial.begin(), initial.end()) {}
+
+  // Returns whether two numbers at different positions in the window sum to
+  // `next`.
+  bool HasPairSum(const std::int64_t next) const {
+    const std::int64_t* values = ring_.data();
+    for (std::size_t idx = 0; idx + 1 < ring_.size(); ++idx) {
+      if (Contains(values + idx + 1, ring_.size() - idx - 1,
+                   next - values[idx])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Drops the oldest number from the window and adds `incoming`.
+  void Slide(const std::int64_t incoming) {
+    ring_[oldest_idx_] = incoming;
+    if (++oldest_idx_ == ring_.size()) oldest_idx_ = 0;
+  }
+
+ private:
+  std::vector<std::int64_t> ring_;
+  std::size_t oldest_idx_ = 0;
+};
+
+// The last `window_size` numbers of the sequence, kept both in arrival order
+// (as a ring buffer) and as a multiset of values, so that checking whether
+// some pair sums to a value costs one hash lookup per window element rather
+// than a pass over every pair.
+class HashWindow {
+ public:
+  explicit HashWindow(absl::Span<const std::int64_t> initial)
+      : ring_(initial.begin(), initial.end()) {
+    counts_.reserve(ring_.size());
+    for (const std::int64_t value : ring_) {
+      ++counts_[value];
+    }
+  }
+
+  // Returns whether two numbers at different positions in the window sum to
+  // `next`.
+  bool HasPairSum(const std::int64_t next) const {
+    for (const std::int64_t value : ring_) {
+      auto iter = counts_.find(next - value);
+      if (iter == counts_.end()) continue;
+      // Pairing a value with itself needs two copies of it in the window.
+      if (next - value != value || iter->second >= 2) return true;
+    }
+    return false;
+  }
+
+  // Drops the oldest number from the window and adds `incoming`.
+  void Slide(const std::int64_t incoming) {
+    std::int64_t& oldest = ring_[oldest_idx_];
+    auto iter = counts_.find(oldest);
+    if (--iter->second == 0) counts_.erase(iter);
+    oldest = incoming;
+    ++counts_[incoming];
+    if (++oldest_idx_ == ring_.size()) oldest_idx_ = 0;
+  }
+
+ private:
+  std::vector<std::int64_t> ring_;
+  std::size_t oldest_idx_ = 0;
+  absl::flat_hash_map<std::int64_t, int> counts_;
+};
+
+template <typename Window>
+std::int64_t FindInvalidNumberWith(absl::Span<const std::int64_t> sequence,
+                                   const int window_size) {
+  Window window(sequence.subspan(0, window_size));
+  for (auto iter = sequence.begin() + window_size; iter != sequence.end();
+       ++iter) {
+    if (!window.HasPairSum(*iter)) return *iter;
+    window.Slide(*iter);
+  }
+  CHECK_FAIL();
+}
+
 }  // namespace
 
 std::int64_t FindInvalidNumber(absl::Span<const std::int64_t> sequence,
                                const int window_size) {
+  CHECK(window_size > 0);
   CHECK(sequence.size() >= window_size);
-  std::deque<std::int64_t> window(sequence.begin(),
-                                  sequence.begin() + window_size);
-  for (auto iter = sequence.begin() + window_size; iter != sequence.end();
-       ++iter) {
-    if (!NextValid(window, *iter)) return *iter;
-    window.pop_front();
-    window.push_back(*iter);
+  if (window_size <= kMaxBruteForceWindow) {
+    return FindInvalidNumberWith<BruteForceWindow>(sequence, window_size);
   }
-  CHECK_FAIL();
+  return FindInvalidNumberWith<HashWindow>(sequence, window_size);
 }
 
 std::int64_t CrackCode(absl::Span<const std::int64_t> sequence,
                        const int window_size) {
-  const std::int64_t target = FindInvalidNumber(sequence, window_size);
-
-  std::int64_t current_sum = 0;
-  auto range_begin = sequence.begin();
-  auto range_end = sequence.begin();
-  while (range_end != sequence.end()) {
-    if (current_sum == target) {
-      auto [min, max] = std::minmax_element(range_begin, range_end);
-      return *min + *max;
-    }
+  return FindWeakness(sequence, FindInvalidNumber(sequence, window_size));
+}
 
-    if (current_sum < target) {
-      current_sum += *range_end;
-      ++range_end;
-      continue;
-    }
+std::int64_t FindWeakness(absl::Span<const std::int64_t> sequence,
+                          const std::int64_t target) {
+  WeaknessStream stream(target);
+  for (const std::int64_t number : sequence) {
+    if (stream.Push(number)) return stream.weakness();
+  }
+  CHECK_FAIL();
+}
 
-    CHECK(current_sum > target);
-    current_sum -= *range_begin;
-    ++range_begin;
+bool WeaknessStream::Push(const std::int64_t next) {
+  range_.push_back(next);
+  range_sum_ += next;
+  while (range_sum_ > target_) {
+    range_sum_ -= range_.front();
+    range_.pop_front();
   }
+  if (range_sum_ != target_ || range_.empty()) return false;
+  auto [min, max] = std::minmax_element(range_.begin(), range_.end());
+  weakness_ = *min + *max;
+  return true;
+}
 
-  CHECK_FAIL();
+class XmasStream::Window {
+ public:
+  virtual ~Window() = default;
+
+  virtual bool HasPairSum(std::int64_t next) const = 0;
+  virtual void Slide(std::int64_t incoming) = 0;
+};
+
+template <typename WindowT>
+class XmasStream::WindowImpl final : public XmasStream::Window {
+ public:
+  explicit WindowImpl(absl::Span<const std::int64_t> initial)
+      : window_(initial) {}
+
+  bool HasPairSum(const std::int64_t next) const override {
+    return window_.HasPairSum(next);
+  }
+
+  void Slide(const std::int64_t incoming) override { window_.Slide(incoming); }
+
+ private:
+  WindowT window_;
+};
+
+XmasStream::XmasStream(const int window_size) : window_size_(window_size) {
+  CHECK(window_size > 0);
+  preamble_.reserve(window_size);
+}
+
+XmasStream::~XmasStream() = default;
+
+bool XmasStream::Push(const std::int64_t next) {
+  if (window_ == nullptr) {
+    preamble_.push_back(next);
+    if (preamble_.size() == static_cast<std::size_t>(window_size_)) {
+      if (window_size_ <= kMaxBruteForceWindow) {
+        window_ = std::make_unique<WindowImpl<BruteForceWindow>>(preamble_);
+      } else {
+        window_ = std::make_unique<WindowImpl<HashWindow>>(preamble_);
+      }
+      preamble_ = std::vector<std::int64_t>();
+    }
+    return false;
+  }
+
+  const bool invalid = !window_->HasPairSum(next);
+  window_->Slide(next);
+  return invalid;
 }
 
 }  // namespace aoc2020::xmas_cipher
@@ -2,6 +2,9 @@
 #define PUZZLES_DAY_09_XMAS_CIPHER_H_
 
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
 
 #include "absl/types/span.h"
 
@@ -13,6 +16,73 @@ std::int64_t FindInvalidNumber(absl::Span<const std::int64_t> sequence,
 std::int64_t CrackCode(absl::Span<const std::int64_t> sequence,
                        int window_size);
 
+// Finds a contiguous range of `sequence` that sums to `target` and returns
+// the sum of the smallest and largest numbers in it. Assumes the numbers are
+// non-negative.
+std::int64_t FindWeakness(absl::Span<const std::int64_t> sequence,
+                          std::int64_t target);
+
+// Push-based FindWeakness(). The range only ever moves forward, so only the
+// numbers currently in it are kept. Example:
+//
+//   WeaknessStream stream(target);
+//   for (std::int64_t number : numbers) {
+//     if (stream.Push(number)) return stream.weakness();
+//   }
+//
+class WeaknessStream {
+ public:
+  explicit WeaknessStream(std::int64_t target) : target_(target) {}
+
+  // Adds `next` to the sequence and returns true once some contiguous range
+  // ending at it sums to the target. Assumes the numbers are non-negative.
+  bool Push(std::int64_t next);
+
+  // The sum of the smallest and largest numbers in the range found. Only
+  // valid once Push() has returned true.
+  std::int64_t weakness() const { return weakness_; }
+
+ private:
+  std::int64_t target_;
+  std::deque<std::int64_t> range_;
+  // The sum of `range_`, which never exceeds `target_` by more than one
+  // number, so it cannot overflow however long the sequence is.
+  std::int64_t range_sum_ = 0;
+  std::int64_t weakness_ = 0;
+};
+
+// Push-based validation of an unbounded XMAS sequence. Only the most recent
+// `window_size` numbers are kept. Example:
+//
+//   XmasStream stream(25);
+//   for (std::int64_t number : numbers) {
+//     if (stream.Push(number)) { ... number is invalid ... }
+//   }
+//
+class XmasStream {
+ public:
+  explicit XmasStream(int window_size);
+  ~XmasStream();
+
+  XmasStream(const XmasStream&) = delete;
+  XmasStream& operator=(const XmasStream&) = delete;
+
+  // Adds `next` to the sequence and returns true if it is invalid, i.e. it is
+  // not the sum of two of the `window_size` numbers before it. Numbers in the
+  // preamble are never invalid.
+  bool Push(std::int64_t next);
+
+ private:
+  class Window;
+  template <typename WindowT>
+  class WindowImpl;
+
+  int window_size_;
+  // Collects the preamble until `window_` can be built from it.
+  std::vector<std::int64_t> preamble_;
+  std::unique_ptr<Window> window_;
+};
+
 }  // namespace aoc2020::xmas_cipher
 
 #endif  // PUZZLES_DAY_09_XMAS_CIPHER_H_
@@ -0,0 +1,42 @@
+#include "puzzles/day_10/arrangement_counter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace aoc2020::day10 {
+
+BigCount::BigCount(const std::uint64_t value)
+    : limbs_{value % kLimbBase} {
+  if (value >= kLimbBase) limbs_.push_back(value / kLimbBase);
+}
+
+BigCount& BigCount::operator+=(const BigCount& other) {
+  if (limbs_.size() < other.limbs_.size()) {
+    limbs_.resize(other.limbs_.size(), 0);
+  }
+  std::uint64_t carry = 0;
+  for (std::size_t idx = 0; idx < limbs_.size(); ++idx) {
+    if (idx >= other.limbs_.size() && carry == 0) break;
+    std::uint64_t sum = limbs_[idx] + carry;
+    if (idx < other.limbs_.size()) sum += other.limbs_[idx];
+    carry = sum >= kLimbBase;
+    limbs_[idx] = carry ? sum - kLimbBase : sum;
+  }
+  if (carry != 0) limbs_.push_back(carry);
+  return *this;
+}
+
+std::string BigCount::ToString() const {
+  std::string result = std::to_string(limbs_.back());
+  char limb_digits[19];
+  for (std::size_t idx = limbs_.size() - 1; idx-- > 0;) {
+    std::snprintf(limb_digits, sizeof(limb_digits), "%018llu",
+                  static_cast<unsigned long long>(limbs_[idx]));
+    result += limb_digits;
+  }
+  return result;
+}
+
+}  // namespace aoc2020::day10
@@ -0,0 +1,70 @@
+#ifndef PUZZLES_DAY_10_ARRANGEMENT_COUNTER_H_
+#define PUZZLES_DAY_10_ARRANGEMENT_COUNTER_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "util/check.h"
+
+namespace aoc2020::day10 {
+
+// An exact, unbounded non-negative count that supports only addition.
+class BigCount {
+ public:
+  explicit BigCount(std::uint64_t value = 0);
+
+  BigCount& operator+=(const BigCount& other);
+
+  // Returns the count in decimal.
+  std::string ToString() const;
+
+  friend std::ostream& operator<<(std::ostream& out, const BigCount& count) {
+    return out << count.ToString();
+  }
+
+ private:
+  // Each limb holds 18 decimal digits, so printing needs no division.
+  static inline constexpr std::uint64_t kLimbBase = 1000000000000000000;
+
+  // Least significant limb first. Never empty.
+  std::vector<std::uint64_t> limbs_;
+};
+
+// Returns the number of distinct chains from the outlet (0 jolts) through some
+// of `sorted_jolts` to the device (3 jolts above the largest adapter), where
+// each step rises by 1 to 3 jolts. `sorted_jolts` must be strictly increasing
+// and non-empty. `Count` is an integer type or a class like BigCount that is
+// constructible from an integer and supports +=.
+//
+// Only the counts for the three joltages just below the current adapter are
+// kept, so apart from the size of `Count` itself this takes constant memory.
+template <typename Count>
+Count CountArrangements(absl::Span<const int> sorted_jolts) {
+  CHECK(!sorted_jolts.empty());
+  // window[k] is the number of chains reaching `last - k` jolts.
+  Count window[3] = {Count(1), Count(0), Count(0)};
+  int last = 0;
+  for (const int jolt : sorted_jolts) {
+    const int step = jolt - last;
+    CHECK(step > 0);
+    Count ways(0);
+    for (int k = 0; k + step < 4; ++k) {
+      ways += window[k];
+    }
+    for (int k = 2; k > 0; --k) {
+      window[k] = k >= step ? std::move(window[k - step]) : Count(0);
+    }
+    window[0] = std::move(ways);
+    last = jolt;
+  }
+  // The device can only be reached from the largest adapter.
+  return std::move(window[0]);
+}
+
+}  // namespace aoc2020::day10
+
+#endif  // PUZZLES_DAY_10_ARRANGEMENT_COUNTER_H_
@@ -1,9 +1,10 @@
-#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "util/check.h"
+#include "util/counting_sort.h"
 #include "util/io.h"
 
 int main(int argc, char** argv) {
@@ -11,32 +12,20 @@ int main(int argc, char** argv) {
   std::vector<std::string> lines = aoc2020::ReadLinesFromFile(argv[1]);
   std::vector<int> jolts = aoc2020::ParseIntegers(lines);
 
-  std::sort(jolts.begin(), jolts.end());
+  // diff_counts[d] is the number of adjacent adapters (starting from the
+  // outlet at 0 jolts) that differ by d jolts.
+  int diff_counts[4] = {0, 0, 0, 0};
+  int previous = 0;
+  aoc2020::CountingSort(absl::MakeSpan(jolts), [&](const int jolt) {
+    const int diff = jolt - previous;
+    CHECK(diff >= 0 && diff <= 3);
+    ++diff_counts[diff];
+    previous = jolt;
+  });
+  // The device is always 3 jolts above the largest adapter.
+  ++diff_counts[3];
 
-  int one_diffs = 0;
-  int three_diffs = 0;
-  switch (jolts.front()) {
-    case 1:
-      ++one_diffs;
-      break;
-    case 3:
-      ++three_diffs;
-      break;
-  }
-
-  for (auto iter = jolts.begin() + 1; iter != jolts.end(); ++iter) {
-    switch (*iter - *(iter - 1)) {
-      case 1:
-        ++one_diffs;
-        break;
-      case 3:
-        ++three_diffs;
-        break;
-    }
-  }
-  ++three_diffs;
-
-  std::cout << (one_diffs * three_diffs) << "\n";
+  std::cout << (diff_counts[1] * diff_counts[3]) << "\n";
 
   return 0;
 }
@@ -0,0 +1,134 @@
+#ifndef PUZZLES_DAY_11_FRONTIER_H_
+#define PUZZLES_DAY_11_FRONTIER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "util/epoch_marks.h"
+
+namespace aoc2020::day11 {
+
+// The cells (seats or bitboard words, identified by dense ids) whose
+// neighborhood changed in the last generation, and which are therefore the
+// only ones that can change in the next. Cells are queued for the next
+// generation while the current one is processed. Duplicates are dropped with
+// EpochMarks, so nothing needs clearing between generations.
+class Frontier {
+ public:
+  explicit Frontier(const std::size_t size) : size_(size) {
+    queued_.NextEpoch(size_);
+  }
+
+  // Queues `id` for the next generation, unless it already is.
+  void Add(const std::uint32_t id) {
+    if (queued_.IsMarked(id)) return;
+    queued_.Mark(id);
+    next_.push_back(id);
+  }
+
+  // Makes the cells queued so far the current generation.
+  void Advance() {
+    std::swap(current_, next_);
+    next_.clear();
+    queued_.NextEpoch(size_);
+  }
+
+  const std::vector<std::uint32_t>& current() const { return current_; }
+
+ private:
+  std::size_t size_;
+  EpochMarks queued_;
+  std::vector<std::uint32_t> current_;
+  std::vector<std::uint32_t> next_;
+};
+
+// Steps a cellular automaton one generation at a time, choosing between a
+// full sweep and a sweep over just the Frontier. After a generation that
+// changes at least 1/`dense_divisor` of the cells, the frontier would cover
+// much of the map, and a full sweep in memory order is cheaper than building
+// it and visiting it cell by cell.
+//
+// A cell's state is a word of bits, and Step() drives the automaton through
+// these members:
+//
+//   // Steps every cell into a second buffer and swaps the two, returning how
+//   // many cells changed.
+//   std::size_t StepDense();
+//   // The bits of `id` that flip in the next generation.
+//   std::uint64_t NextFlips(std::uint32_t id) const;
+//   // The bits of `id` that the last StepDense() flipped.
+//   std::uint64_t LastFlips(std::uint32_t id) const;
+//   void Flip(std::uint32_t id, std::uint64_t bits);
+//   // Adds every cell whose next state depends on `bits` of `id`.
+//   void QueueAround(std::uint32_t id, std::uint64_t bits,
+//                    Frontier* frontier) const;
+class FrontierStepper {
+ public:
+  FrontierStepper(const std::size_t num_cells, const std::size_t dense_divisor)
+      : num_cells_(num_cells),
+        dense_divisor_(dense_divisor),
+        frontier_(num_cells) {}
+
+  // Advances `automaton` one generation. Returns false if nothing changed.
+  template <typename Automaton>
+  bool Step(Automaton& automaton) {
+    const bool was_dense = dense_;
+    std::size_t num_changed = 0;
+    if (was_dense) {
+      num_changed = automaton.StepDense();
+    } else {
+      // Every cell in the frontier is evaluated before any is updated, so
+      // that all of them see the same generation. Cells outside the frontier
+      // are unchanged, so the update happens in place; the buffer StepDense()
+      // swaps in goes stale, but it overwrites all of it before reading it.
+      changes_.clear();
+      for (const std::uint32_t id : frontier_.current()) {
+        const std::uint64_t bits = automaton.NextFlips(id);
+        if (bits != 0) changes_.push_back(Change{.id = id, .bits = bits});
+      }
+      for (const Change& change : changes_) {
+        automaton.Flip(change.id, change.bits);
+      }
+      num_changed = changes_.size();
+    }
+
+    dense_ = num_changed * dense_divisor_ >= num_cells_;
+    if (dense_) return num_changed != 0;
+
+    if (was_dense) {
+      // A dense step leaves the previous generation in its second buffer, so
+      // what changed can be recovered by comparing.
+      changes_.clear();
+      for (std::uint32_t id = 0; id < num_cells_; ++id) {
+        const std::uint64_t bits = automaton.LastFlips(id);
+        if (bits != 0) changes_.push_back(Change{.id = id, .bits = bits});
+      }
+    }
+    for (const Change& change : changes_) {
+      automaton.QueueAround(change.id, change.bits, &frontier_);
+    }
+    frontier_.Advance();
+    return num_changed != 0;
+  }
+
+ private:
+  struct Change {
+    std::uint32_t id;
+    // The bits that flipped.
+    std::uint64_t bits;
+  };
+
+  std::size_t num_cells_;
+  std::size_t dense_divisor_;
+  // Whether the next step sweeps every cell. Otherwise it visits only
+  // `frontier_`.
+  bool dense_ = true;
+  Frontier frontier_;
+  std::vector<Change> changes_;
+};
+
+}  // namespace aoc2020::day11
+
+#endif  // PUZZLES_DAY_11_FRONTIER_H_
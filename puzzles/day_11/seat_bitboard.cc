@@ -0,0 +1,138 @@
+#include "puzzles/day_11/seat_bitboard.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/check.h"
+
+namespace aoc2020::day11 {
+namespace {
+
+// Sums three one-bit planes into a two-bit count (`low`, `high`).
+void FullAdd(const std::uint64_t a, const std::uint64_t b,
+             const std::uint64_t c, std::uint64_t* low, std::uint64_t* high) {
+  const std::uint64_t partial = a ^ b;
+  *low = partial ^ c;
+  *high = (a & b) | (partial & c);
+}
+
+}  // namespace
+
+SeatBitboard::SeatBitboard(const std::vector<std::string>& rows)
+    : height_(rows.size()),
+      width_(rows.empty() ? 0 : rows.front().size()),
+      words_per_row_((width_ + kLowMask) >> kHighShift),
+      seats_((height_ + 2) * words_per_row_, 0),
+      occupied_(seats_.size(), 0),
+      next_occupied_(seats_.size(), 0),
+      stepper_(seats_.size(), kDenseDivisor) {
+  for (std::size_t vertical = 0; vertical < height_; ++vertical) {
+    CHECK(rows[vertical].size() == width_);
+    const std::size_t row_offset = (vertical + 1) * words_per_row_;
+    for (std::size_t horizontal = 0; horizontal < width_; ++horizontal) {
+      const char cell = rows[vertical][horizontal];
+      const std::uint64_t bit = std::uint64_t{1} << (horizontal & kLowMask);
+      const std::size_t idx = row_offset + (horizontal >> kHighShift);
+      if (cell != '.') seats_[idx] |= bit;
+      if (cell == '#') occupied_[idx] |= bit;
+    }
+  }
+}
+
+std::uint64_t SeatBitboard::NextWord(const std::size_t row,
+                                     const std::size_t word) const {
+  // Returns the occupancy of the cells to the west (`west`), at (`center`)
+  // and to the east (`east`) of each cell covered by `word` in padded row
+  // `neighbor_row`. Bits shifted in across word boundaries come from the
+  // adjacent words; past the edges of the map they are zero.
+  const auto shifted = [&](const std::size_t neighbor_row, std::uint64_t* west,
+                           std::uint64_t* center, std::uint64_t* east) {
+    const std::uint64_t* words = &occupied_[neighbor_row * words_per_row_];
+    *center = words[word];
+    const std::uint64_t before = word > 0 ? words[word - 1] : 0;
+    const std::uint64_t after = word + 1 < words_per_row_ ? words[word + 1] : 0;
+    *west = (*center << 1) | (before >> 63);
+    *east = (*center >> 1) | (after << 63);
+  };
+
+  std::uint64_t west, center, east;
+  std::uint64_t above_low, above_high;
+  shifted(row - 1, &west, &center, &east);
+  FullAdd(west, center, east, &above_low, &above_high);
+  std::uint64_t below_low, below_high;
+  shifted(row + 1, &west, &center, &east);
+  FullAdd(west, center, east, &below_low, &below_high);
+  std::uint64_t self;
+  shifted(row, &west, &self, &east);
+  const std::uint64_t side_low = west ^ east;
+  const std::uint64_t side_high = west & east;
+
+  // above + below, a three-bit count.
+  const std::uint64_t sum_low = above_low ^ below_low;
+  const std::uint64_t carry_low = above_low & below_low;
+  const std::uint64_t partial_mid = above_high ^ below_high;
+  const std::uint64_t sum_mid = partial_mid ^ carry_low;
+  const std::uint64_t sum_high =
+      (above_high & below_high) | (partial_mid & carry_low);
+
+  // ... + side, the full four-bit neighbor count.
+  const std::uint64_t count0 = sum_low ^ side_low;
+  const std::uint64_t carry0 = sum_low & side_low;
+  const std::uint64_t partial1 = sum_mid ^ side_high;
+  const std::uint64_t count1 = partial1 ^ carry0;
+  const std::uint64_t carry1 = (sum_mid & side_high) | (partial1 & carry0);
+  const std::uint64_t count2 = sum_high ^ carry1;
+  const std::uint64_t count3 = sum_high & carry1;
+
+  const std::uint64_t no_neighbors = ~(count0 | count1 | count2 | count3);
+  const std::uint64_t crowded = count2 | count3;
+  return seats_[row * words_per_row_ + word] &
+         (no_neighbors | (self & ~crowded));
+}
+
+void SeatBitboard::QueueAround(const std::uint32_t idx,
+                               const std::uint64_t bits,
+                               Frontier* frontier) const {
+  const std::size_t row = idx / words_per_row_;
+  const std::size_t word = idx % words_per_row_;
+  // Bits in the middle of a word only affect that word's column of words;
+  // the lowest and highest bits also reach across to the adjacent column.
+  const bool west = (bits & 1) != 0 && word > 0;
+  const bool east = (bits >> 63) != 0 && word + 1 < words_per_row_;
+  for (std::size_t neighbor_row = std::max<std::size_t>(row - 1, 1);
+       neighbor_row <= std::min(row + 1, height_); ++neighbor_row) {
+    const std::size_t neighbor = neighbor_row * words_per_row_ + word;
+    frontier->Add(neighbor);
+    if (west) frontier->Add(neighbor - 1);
+    if (east) frontier->Add(neighbor + 1);
+  }
+}
+
+std::size_t SeatBitboard::StepDense() {
+  std::size_t num_changed = 0;
+  for (std::size_t row = 1; row <= height_; ++row) {
+    for (std::size_t word = 0; word < words_per_row_; ++word) {
+      const std::size_t idx = row * words_per_row_ + word;
+      next_occupied_[idx] = NextWord(row, word);
+      num_changed += next_occupied_[idx] != occupied_[idx];
+    }
+  }
+  std::swap(occupied_, next_occupied_);
+  return num_changed;
+}
+
+bool SeatBitboard::Step() { return stepper_.Step(*this); }
+
+std::int64_t SeatBitboard::CountOccupied() const {
+  std::int64_t total = 0;
+  for (const std::uint64_t word : occupied_) {
+    total += __builtin_popcountll(word);
+  }
+  return total;
+}
+
+}  // namespace aoc2020::day11
@@ -0,0 +1,79 @@
+#ifndef PUZZLES_DAY_11_SEAT_BITBOARD_H_
+#define PUZZLES_DAY_11_SEAT_BITBOARD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "puzzles/day_11/frontier.h"
+
+namespace aoc2020::day11 {
+
+// The part 1 seating automaton on a bitboard. The map is held as two bit
+// planes, one marking seats and one marking occupied seats, each row packed
+// into a whole number of 64-bit words. A zero row above and below the map
+// means the rows around any map row can be read without bounds checks.
+//
+// A generation works on 64 seats at a time: the eight neighbor masks of a word
+// are summed with bit-sliced adders into four count planes, from which "no
+// neighbors" and "at least four neighbors" fall out as plain masks.
+// Occupancy is double-buffered, so stepping allocates nothing.
+//
+// Only words next to a word that changed in the last generation can change
+// in the next. Once few enough words are changing, a FrontierStepper tracks
+// those and the rest of the map is skipped. The map has settled once a
+// generation changes nothing.
+class SeatBitboard {
+ public:
+  // `rows` is the puzzle input, one string per row, all the same width.
+  explicit SeatBitboard(const std::vector<std::string>& rows);
+
+  // Advances one generation. Returns false if nothing changed, i.e. the map
+  // had already reached its fixpoint.
+  bool Step();
+
+  std::int64_t CountOccupied() const;
+
+ private:
+  static inline constexpr std::size_t kHighShift = 6;
+  static inline constexpr std::size_t kLowMask = 63;
+
+  // Words are cheap to sweep, so the whole map is stepped until fewer than a
+  // quarter of them change.
+  static inline constexpr std::size_t kDenseDivisor = 4;
+
+  friend class FrontierStepper;
+
+  // Computes the next occupancy of word `word` of padded row `row`.
+  std::uint64_t NextWord(std::size_t row, std::size_t word) const;
+
+  // The FrontierStepper interface. Cell ids are word indices into the planes.
+  std::size_t StepDense();
+  std::uint64_t NextFlips(const std::uint32_t idx) const {
+    return NextWord(idx / words_per_row_, idx % words_per_row_) ^
+           occupied_[idx];
+  }
+  std::uint64_t LastFlips(const std::uint32_t idx) const {
+    return occupied_[idx] ^ next_occupied_[idx];
+  }
+  void Flip(const std::uint32_t idx, const std::uint64_t bits) {
+    occupied_[idx] ^= bits;
+  }
+  void QueueAround(std::uint32_t idx, std::uint64_t bits,
+                   Frontier* frontier) const;
+
+  std::size_t height_ = 0;
+  std::size_t width_ = 0;
+  std::size_t words_per_row_ = 0;
+  // Both planes have `height_ + 2` rows of `words_per_row_` words; padded row
+  // r + 1 holds map row r.
+  std::vector<std::uint64_t> seats_;
+  std::vector<std::uint64_t> occupied_;
+  std::vector<std::uint64_t> next_occupied_;
+  FrontierStepper stepper_;
+};
+
+}  // namespace aoc2020::day11
+
+#endif  // PUZZLES_DAY_11_SEAT_BITBOARD_H_
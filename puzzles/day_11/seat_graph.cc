@@ -0,0 +1,138 @@
+#include "puzzles/day_11/seat_graph.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/check.h"
+
+namespace aoc2020::day11 {
+
+SeatGraph::SeatGraph(const std::vector<std::string>& rows)
+    : stepper_(0, kDenseDivisor) {
+  const std::size_t height = rows.size();
+  const std::size_t width = rows.empty() ? 0 : rows.front().size();
+
+  // Number the seats in row-major order.
+  std::vector<std::int32_t> seat_ids(height * width, -1);
+  for (std::size_t vertical = 0; vertical < height; ++vertical) {
+    CHECK(rows[vertical].size() == width);
+    for (std::size_t horizontal = 0; horizontal < width; ++horizontal) {
+      const char cell = rows[vertical][horizontal];
+      if (cell == '.') continue;
+      seat_ids[vertical * width + horizontal] = num_seats_;
+      occupied_.push_back(cell == '#');
+      ++num_seats_;
+    }
+  }
+  occupied_.push_back(0);
+  next_occupied_.resize(occupied_.size(), 0);
+
+  // Visibility is symmetric, so sweeping the map once in row-major order and
+  // looking back to the west, northwest, north and northeast finds every
+  // pair. The last seat seen along each row, column and diagonal is enough
+  // to answer those lookups.
+  neighbors_.resize(kSlots * num_seats_, num_seats_);
+  std::vector<std::size_t> degrees(num_seats_, 0);
+  const auto connect = [&](const std::int32_t a, const std::int32_t b) {
+    neighbors_[degrees[a]++ * num_seats_ + a] = b;
+    neighbors_[degrees[b]++ * num_seats_ + b] = a;
+  };
+  std::vector<std::int32_t> last_in_column(width, -1);
+  // Indexed by horizontal - vertical + height - 1.
+  std::vector<std::int32_t> last_in_diagonal(width + height, -1);
+  // Indexed by horizontal + vertical.
+  std::vector<std::int32_t> last_in_antidiagonal(width + height, -1);
+  for (std::size_t vertical = 0; vertical < height; ++vertical) {
+    std::int32_t last_in_row = -1;
+    for (std::size_t horizontal = 0; horizontal < width; ++horizontal) {
+      const std::int32_t seat = seat_ids[vertical * width + horizontal];
+      if (seat < 0) continue;
+      for (std::int32_t* last :
+           {&last_in_row, &last_in_column[horizontal],
+            &last_in_diagonal[horizontal + height - 1 - vertical],
+            &last_in_antidiagonal[horizontal + vertical]}) {
+        if (*last >= 0) connect(*last, seat);
+        *last = seat;
+      }
+    }
+  }
+
+  stepper_ = FrontierStepper(num_seats_, kDenseDivisor);
+}
+
+void SeatGraph::QueueAround(const std::uint32_t seat,
+                            std::uint64_t /*bits*/,
+                            Frontier* frontier) const {
+  frontier->Add(seat);
+  for (std::size_t slot = 0; slot < kSlots; ++slot) {
+    const std::int32_t neighbor = neighbors_[slot * num_seats_ + seat];
+    if (static_cast<std::size_t>(neighbor) == num_seats_) break;
+    frontier->Add(neighbor);
+  }
+}
+
+std::size_t SeatGraph::StepDense() {
+  std::size_t seat = 0;
+  std::size_t num_changed = 0;
+#if defined(__AVX2__)
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i five = _mm256_set1_epi32(5);
+  __m256i changed_counts = zero;
+  for (; seat + 8 <= num_seats_; seat += 8) {
+    __m256i counts = zero;
+    for (std::size_t slot = 0; slot < kSlots; ++slot) {
+      const __m256i indices =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+              &neighbors_[slot * num_seats_ + seat]));
+      counts = _mm256_add_epi32(
+          counts, _mm256_i32gather_epi32(occupied_.data(), indices, 4));
+    }
+    const __m256i current = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&occupied_[seat]));
+    // Occupied seats stay occupied below five neighbors; empty ones fill up
+    // with none.
+    const __m256i next_if_occupied = _mm256_cmpgt_epi32(five, counts);
+    const __m256i next_if_empty = _mm256_cmpeq_epi32(counts, zero);
+    const __m256i next = _mm256_and_si256(
+        _mm256_blendv_epi8(next_if_empty, next_if_occupied,
+                           _mm256_cmpeq_epi32(current, one)),
+        one);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&next_occupied_[seat]),
+                        next);
+    changed_counts =
+        _mm256_add_epi32(changed_counts, _mm256_xor_si256(next, current));
+  }
+  alignas(32) std::int32_t lane_counts[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lane_counts), changed_counts);
+  for (const std::int32_t lane_count : lane_counts) {
+    num_changed += lane_count;
+  }
+#endif  // __AVX2__
+  for (; seat < num_seats_; ++seat) {
+    next_occupied_[seat] = NextState(seat);
+    num_changed += next_occupied_[seat] != occupied_[seat];
+  }
+  std::swap(occupied_, next_occupied_);
+  return num_changed;
+}
+
+bool SeatGraph::Step() { return stepper_.Step(*this); }
+
+std::int64_t SeatGraph::CountOccupied() const {
+  std::int64_t total = 0;
+  for (const std::int32_t occupied : occupied_) {
+    total += occupied;
+  }
+  return total;
+}
+
+}  // namespace aoc2020::day11
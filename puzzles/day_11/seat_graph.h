@@ -0,0 +1,84 @@
+#ifndef PUZZLES_DAY_11_SEAT_GRAPH_H_
+#define PUZZLES_DAY_11_SEAT_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "puzzles/day_11/frontier.h"
+
+namespace aoc2020::day11 {
+
+// The part 2 seating automaton. Floor never changes, so the seat visible in
+// each of the eight directions from every seat is found once, up front, and
+// each generation is then a flat loop over seats that sums the occupancy of
+// their precomputed neighbors.
+//
+// A seat sees at most eight others, so rather than a CSR offsets array every
+// seat gets exactly eight neighbor slots, with missing neighbors pointing at
+// an extra, permanently empty seat. The slots are stored slot-major, so that
+// slot k of eight consecutive seats can be loaded as one vector of gather
+// indices.
+//
+// As with SeatBitboard, once few enough seats are changing, only those that
+// can see a seat that changed in the last generation are re-evaluated.
+class SeatGraph {
+ public:
+  // `rows` is the puzzle input, one string per row, all the same width.
+  explicit SeatGraph(const std::vector<std::string>& rows);
+
+  // Advances one generation. Returns false if nothing changed, i.e. the map
+  // had already reached its fixpoint.
+  bool Step();
+
+  std::int64_t CountOccupied() const;
+
+ private:
+  static inline constexpr std::size_t kSlots = 8;
+
+  // A seat costs eight gathers to step, so the sweep over every seat only
+  // pays while at least one in sixteen is changing.
+  static inline constexpr std::size_t kDenseDivisor = 16;
+
+  friend class FrontierStepper;
+
+  // Returns the occupancy of `seat` in the next generation.
+  std::int32_t NextState(std::size_t seat) const {
+    std::int32_t count = 0;
+    for (std::size_t slot = 0; slot < kSlots; ++slot) {
+      count += occupied_[neighbors_[slot * num_seats_ + seat]];
+    }
+    return occupied_[seat] ? count < 5 : count == 0;
+  }
+
+  // The FrontierStepper interface. Cell ids are seats, and a seat's only bit
+  // is whether it is occupied.
+  std::size_t StepDense();
+  std::uint64_t NextFlips(const std::uint32_t seat) const {
+    return NextState(seat) ^ occupied_[seat];
+  }
+  std::uint64_t LastFlips(const std::uint32_t seat) const {
+    return occupied_[seat] ^ next_occupied_[seat];
+  }
+  void Flip(const std::uint32_t seat, std::uint64_t /*bits*/) {
+    occupied_[seat] ^= 1;
+  }
+  // Queues `seat` and every seat that can see it.
+  void QueueAround(std::uint32_t seat, std::uint64_t bits,
+                   Frontier* frontier) const;
+
+  std::size_t num_seats_ = 0;
+  // neighbors_[slot * num_seats_ + seat] is a seat visible from `seat`, or
+  // `num_seats_` if there are fewer than `slot + 1`.
+  std::vector<std::int32_t> neighbors_;
+  // One entry per seat plus the trailing always-empty one; 1 if occupied.
+  // 32 bits wide to suit gathers.
+  std::vector<std::int32_t> occupied_;
+  std::vector<std::int32_t> next_occupied_;
+  FrontierStepper stepper_;
+};
+
+}  // namespace aoc2020::day11
+
+#endif  // PUZZLES_DAY_11_SEAT_GRAPH_H_
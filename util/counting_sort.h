@@ -0,0 +1,86 @@
+#ifndef UTIL_COUNTING_SORT_H_
+#define UTIL_COUNTING_SORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "util/check.h"
+
+namespace aoc2020 {
+
+// The largest key range, max_key - min_key, that CountingSort() will allocate
+// counts for.
+inline constexpr std::size_t kMaxCountingSortRange = std::size_t{1} << 28;
+
+// Sorts `values`, each of which must lie in [min_key, max_key], in
+// O(n + range) time by counting how often each key occurs and then writing
+// the values back out in order. `on_sorted(value)` is called for each value
+// as it is written, so a single pass can both sort and summarize (e.g.
+// histogram adjacent differences).
+template <typename Int, typename Fn>
+void CountingSort(absl::Span<Int> values, const Int min_key,
+                  const Int max_key, Fn on_sorted) {
+  static_assert(std::is_integral_v<Int>, "counting sort needs integers");
+  CHECK(min_key <= max_key);
+  // Offsets from the minimum are computed unsigned so that they cannot
+  // overflow, even across the full range of a signed type.
+  using Unsigned = std::make_unsigned_t<Int>;
+  const Unsigned min = static_cast<Unsigned>(min_key);
+  const auto offset_of = [min](const Int value) {
+    return static_cast<Unsigned>(static_cast<Unsigned>(value) - min);
+  };
+  const Unsigned range = offset_of(max_key);
+  CHECK(range <= kMaxCountingSortRange);
+
+  std::vector<std::size_t> counts(static_cast<std::size_t>(range) + 1, 0);
+  for (const Int value : values) {
+    const Unsigned offset = offset_of(value);
+    CHECK(offset <= range);
+    ++counts[offset];
+  }
+  auto out = values.begin();
+  for (std::size_t offset = 0; offset < counts.size(); ++offset) {
+    const Int value = static_cast<Int>(min + offset);
+    for (std::size_t copy = 0; copy < counts[offset]; ++copy) {
+      *out++ = value;
+      on_sorted(value);
+    }
+  }
+}
+
+// As above, with the key range taken from the values themselves. If that
+// range is large compared to their number, the count array would dominate,
+// so this falls back to std::sort followed by a pass over the result.
+template <typename Int, typename Fn>
+void CountingSort(absl::Span<Int> values, Fn on_sorted) {
+  static_assert(std::is_integral_v<Int>, "counting sort needs integers");
+  if (values.empty()) return;
+
+  const auto [min_iter, max_iter] =
+      std::minmax_element(values.begin(), values.end());
+  const Int min_key = *min_iter;
+  const Int max_key = *max_iter;
+  using Unsigned = std::make_unsigned_t<Int>;
+  const Unsigned range = static_cast<Unsigned>(
+      static_cast<Unsigned>(max_key) - static_cast<Unsigned>(min_key));
+  if (range >= 4 * values.size() + 1024 || range > kMaxCountingSortRange) {
+    std::sort(values.begin(), values.end());
+    for (const Int value : values) {
+      on_sorted(value);
+    }
+    return;
+  }
+  CountingSort(values, min_key, max_key, on_sorted);
+}
+
+template <typename Int>
+void CountingSort(absl::Span<Int> values) {
+  CountingSort(values, [](Int) {});
+}
+
+}  // namespace aoc2020
+
+#endif  // UTIL_COUNTING_SORT_H_
@@ -0,0 +1,59 @@
+// Times CountingSort() against std::sort on random ints drawn from a few key
+// ranges, and checks that both give the same order. Usage:
+// counting_sort_bench [num_values [seed]].
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "absl/types/span.h"
+#include "util/check.h"
+#include "util/counting_sort.h"
+
+namespace {
+
+// Returns how long `sort(values)` takes, in milliseconds.
+template <typename Sort>
+double TimeSort(std::vector<int>& values, Sort sort) {
+  const auto start = std::chrono::steady_clock::now();
+  sort(values);
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CHECK(argc <= 3);
+  int num_values = 10000000;
+  std::uint32_t seed = 1;
+  if (argc >= 2) CHECK(absl::SimpleAtoi(argv[1], &num_values));
+  if (argc >= 3) CHECK(absl::SimpleAtoi(argv[2], &seed));
+  CHECK(num_values > 0);
+
+  std::mt19937 rng(seed);
+  for (const int range : {1000, 1 << 20, 10000000, 1 << 30}) {
+    std::uniform_int_distribution<int> distribution(0, range - 1);
+    std::vector<int> values(num_values);
+    for (int& value : values) {
+      value = distribution(rng);
+    }
+    std::vector<int> expected = values;
+
+    const double std_sort_ms = TimeSort(expected, [](std::vector<int>& v) {
+      std::sort(v.begin(), v.end());
+    });
+    const double counting_sort_ms = TimeSort(values, [](std::vector<int>& v) {
+      aoc2020::CountingSort(absl::MakeSpan(v));
+    });
+    CHECK(values == expected);
+    std::cout << "range " << range << ": CountingSort " << counting_sort_ms
+              << " ms, std::sort " << std_sort_ms << " ms\n";
+  }
+  return 0;
+}
@@ -0,0 +1,47 @@
+#ifndef UTIL_EPOCH_MARKS_H_
+#define UTIL_EPOCH_MARKS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace aoc2020 {
+
+// A set of marked ids in [0, size) that can be cleared in O(1). Each id holds
+// the epoch in which it was last marked, and starting a new epoch unmarks
+// everything at once. Example:
+//
+//   EpochMarks visited;
+//   visited.NextEpoch(num_nodes);
+//   if (!visited.IsMarked(node)) visited.Mark(node);
+//
+class EpochMarks {
+ public:
+  // Unmarks every id and makes [0, size) addressable. Returns the new epoch,
+  // which is the value a marked id holds in data().
+  std::uint32_t NextEpoch(const std::size_t size) {
+    if (marks_.size() < size) marks_.resize(size, 0);
+    if (++epoch_ == 0) {
+      // Wrapped around; old marks could now alias the new epoch.
+      std::fill(marks_.begin(), marks_.end(), 0);
+      epoch_ = 1;
+    }
+    return epoch_;
+  }
+
+  bool IsMarked(const std::size_t id) const { return marks_[id] == epoch_; }
+  void Mark(const std::size_t id) { marks_[id] = epoch_; }
+
+  // The raw marks, for hot loops (or generated code) that compare against the
+  // epoch themselves.
+  std::uint32_t* data() { return marks_.data(); }
+
+ private:
+  std::vector<std::uint32_t> marks_;
+  std::uint32_t epoch_ = 0;
+};
+
+}  // namespace aoc2020
+
+#endif  // UTIL_EPOCH_MARKS_H_
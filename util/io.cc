@@ -38,6 +38,14 @@ std::vector<std::string> ReadLinesFromFile(const char* filename) {
   return all_lines;
 }
 
+LineReader::LineReader(const char* filename) : stream_(filename) {
+  CHECK(stream_);
+}
+
+bool LineReader::Next(std::string* line) {
+  return static_cast<bool>(std::getline(stream_, *line));
+}
+
 std::vector<std::string> ReadCommaDelimitedFile(const char* filename) {
   std::string contents = ReadFile(filename);
   return absl::StrSplit(contents, ',');
@@ -2,6 +2,7 @@
 #define UTIL_IO_H_
 
 #include <cstddef>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,27 @@ std::string ReadFile(const char* filename);
 // Returns each of the lines in the text file specified by `filename`.
 std::vector<std::string> ReadLinesFromFile(const char* filename);
 
+// Reads the text file specified by `filename` one line at a time, without
+// holding more than the current line in memory. Example:
+//
+//   LineReader reader(filename);
+//   std::string line;
+//   while (reader.Next(&line)) {
+//     ...
+//   }
+//
+class LineReader {
+ public:
+  explicit LineReader(const char* filename);
+
+  // Reads the next line into `line`. Returns false once the end of the file
+  // has been reached.
+  bool Next(std::string* line);
+
+ private:
+  std::ifstream stream_;
+};
+
 // Returns comma-delimited strings from `filename`.
 std::vector<std::string> ReadCommaDelimitedFile(const char* filename);
 